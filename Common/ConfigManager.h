@@ -4,6 +4,8 @@
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
 
+#include "Define/GameConstants.h"
+
 // ==========================================
 // [테스트 코드 사용 예]
 //   ConfigManager testCfg;
@@ -28,13 +30,22 @@ private:
     short game_world_conn_port_       = 0;
     int   game_max_thread_count_      = 0;
     int   game_ai_thread_count_       = 0;
+    float aoi_lod_near_radius_        = GameConstants::Map::AOI_LOD_NEAR_RADIUS;
+    float aoi_lod_mid_radius_         = GameConstants::Map::AOI_LOD_MID_RADIUS;
+    int   aoi_lod_mid_interval_       = static_cast<int>(GameConstants::Map::AOI_LOD_MID_INTERVAL);
+    int   aoi_lod_far_interval_       = static_cast<int>(GameConstants::Map::AOI_LOD_FAR_INTERVAL);
+    int   aoi_lod_settle_ms_          = static_cast<int>(GameConstants::Map::AOI_LOD_SETTLE_MS);
     short gateway_server_port_        = 0;
     short gateway_game_conn_port_     = 0;
     int   gateway_max_thread_count_   = 0;
+    int   gateway_id_                 = 1;
+    int   gateway_game_lane_count_    = 1;
+    bool  gateway_thread_per_core_    = false;
     short login_server_port_          = 0;
     short login_world_conn_port_      = 0;
     int   login_max_thread_count_     = 0;
     int   login_db_thread_count_      = 0;
+    bool  login_thread_per_core_      = false;
     short world_server_port_          = 0;
     int   stress_target_connections_  = 0;
     int   stress_spawn_rate_          = 0;
@@ -86,14 +97,28 @@ public:
             game_max_thread_count_   = pt.get<int>("game_server_info.max_thread_count");
             game_ai_thread_count_    = pt.get<int>("game_server_info.ai_thread_count");
 
+            //   맵별 AOI LOD 튜닝 (미지정 시 GameConstants 기본값, 주기는 최소 1)
+            aoi_lod_near_radius_  = pt.get<float>("game_server_info.aoi_lod.near_radius", GameConstants::Map::AOI_LOD_NEAR_RADIUS);
+            aoi_lod_mid_radius_   = pt.get<float>("game_server_info.aoi_lod.mid_radius", GameConstants::Map::AOI_LOD_MID_RADIUS);
+            aoi_lod_mid_interval_ = pt.get<int>("game_server_info.aoi_lod.mid_interval", static_cast<int>(GameConstants::Map::AOI_LOD_MID_INTERVAL));
+            aoi_lod_far_interval_ = pt.get<int>("game_server_info.aoi_lod.far_interval", static_cast<int>(GameConstants::Map::AOI_LOD_FAR_INTERVAL));
+            aoi_lod_settle_ms_    = pt.get<int>("game_server_info.aoi_lod.settle_ms", static_cast<int>(GameConstants::Map::AOI_LOD_SETTLE_MS));
+            if (aoi_lod_mid_interval_ < 1) aoi_lod_mid_interval_ = 1;
+            if (aoi_lod_far_interval_ < 1) aoi_lod_far_interval_ = 1;
+            if (aoi_lod_settle_ms_ < 0) aoi_lod_settle_ms_ = 0;
+
             gateway_server_port_     = pt.get<short>("gateway_server_info.gateway_server_port");
             gateway_game_conn_port_  = pt.get<short>("gateway_server_info.game_conn_port");
             gateway_max_thread_count_ = pt.get<int>("gateway_server_info.max_thread_count");
+            gateway_id_              = pt.get<int>("gateway_server_info.gateway_id", 1);
+            gateway_game_lane_count_ = pt.get<int>("gateway_server_info.game_conn_lane_count", 1);
+            gateway_thread_per_core_ = pt.get<bool>("gateway_server_info.thread_per_core", false);
 
             login_server_port_       = pt.get<short>("login_server_info.login_server_port");
             login_world_conn_port_   = pt.get<short>("login_server_info.world_conn_port");
             login_max_thread_count_  = pt.get<int>("login_server_info.max_thread_count");
             login_db_thread_count_   = pt.get<int>("login_server_info.db_thread_count");
+            login_thread_per_core_   = pt.get<bool>("login_server_info.thread_per_core", false);
 
             world_server_port_ = pt.get<short>("world_server_info.world_server_port");
 
@@ -103,6 +128,15 @@ public:
             stress_login_server_ip_    = pt.get<std::string>("stress_test_tool_info.login_server_ip");
             stress_login_server_port_  = pt.get<short>("stress_test_tool_info.login_server_port");
 
+            // gateway_id는 세션 핸들 상위 비트(라우팅 키)에 그대로 실리므로 잘라내지 않고 거부
+            //   -> Gateway 프로세스마다 고유해야 함 (중복 ID는 GameServer가 LaneHello에서 거부)
+            //   -> 0이면 무효 핸들과 구분 불가, 범위를 넘으면 다른 Gateway ID와 충돌 (예: 1과 257)
+            if (gateway_id_ < 1 || gateway_id_ > GameConstants::Network::MAX_GATEWAY_ID) {
+                std::cerr << "[ConfigManager] gateway_server_info.gateway_id 범위 오류: " << gateway_id_
+                    << " (허용: 1~" << GameConstants::Network::MAX_GATEWAY_ID << ")\n";
+                return false;
+            }
+
             std::cout << "[ConfigManager] 환경 설정 로드 성공! (DB 연동: "
                 << (db_conn_ ? "ON" : "OFF") << ", Redis 연동: "
                 << (redis_conn_ ? "ON" : "OFF") << ")\n";
@@ -136,13 +170,22 @@ public:
     short GetGameWorldConnPort()        const { return game_world_conn_port_; }
     int   GetGameMaxThreadCount()       const { return game_max_thread_count_; }
     int   GetGameAiThreadCount()        const { return game_ai_thread_count_; }
+    float GetAoiLodNearRadius()         const { return aoi_lod_near_radius_; }
+    float GetAoiLodMidRadius()          const { return aoi_lod_mid_radius_; }
+    int   GetAoiLodMidInterval()        const { return aoi_lod_mid_interval_; }
+    int   GetAoiLodFarInterval()        const { return aoi_lod_far_interval_; }
+    int   GetAoiLodSettleMs()           const { return aoi_lod_settle_ms_; }
     short GetGatewayServerPort()        const { return gateway_server_port_; }
     short GetGatewayGameConnPort()      const { return gateway_game_conn_port_; }
     int   GetGatewayMaxThreadCount()    const { return gateway_max_thread_count_; }
+    int   GetGatewayId()                const { return gateway_id_; }
+    int   GetGatewayGameLaneCount()     const { return gateway_game_lane_count_; }
+    bool  IsGatewayThreadPerCore()      const { return gateway_thread_per_core_; }
     short GetLoginServerPort()          const { return login_server_port_; }
     short GetLoginWorldConnPort()       const { return login_world_conn_port_; }
     int   GetLoginMaxThreadCount()      const { return login_max_thread_count_; }
     int   GetLoginDbThreadCount()       const { return login_db_thread_count_; }
+    bool  IsLoginThreadPerCore()        const { return login_thread_per_core_; }
     short GetWorldServerPort()          const { return world_server_port_; }
     int   GetStressTargetConnections()  const { return stress_target_connections_; }
     int   GetStressSpawnRate()          const { return stress_spawn_rate_; }
@@ -163,4 +206,8 @@ public:
     void SetGameMaxThreadCount(int cnt)     { game_max_thread_count_ = cnt; }
     void SetLoginMaxThreadCount(int cnt)    { login_max_thread_count_ = cnt; }
     void SetGatewayMaxThreadCount(int cnt)  { gateway_max_thread_count_ = cnt; }
+    void SetGatewayId(int id)               { gateway_id_ = id; }
+    void SetGatewayGameLaneCount(int cnt)   { gateway_game_lane_count_ = cnt; }
+    void SetGatewayThreadPerCore(bool use)  { gateway_thread_per_core_ = use; }
+    void SetLoginThreadPerCore(bool use)    { login_thread_per_core_ = use; }
 };
@@ -1,4 +1,5 @@
 ﻿#pragma once
 
 #define  DEF_ADD_RECASTNAVI					// RecastNavigation lib 추가
-#define  DEF_STRESS_TEST_DEADLOCK_WATCHDOG	// 교착 상태나 무한 루프(프리즈) 현상을 감지하기 위해 워치독(Watchdog, 감시견) 스레드 추가
\ No newline at end of file
+#define  DEF_STRESS_TEST_DEADLOCK_WATCHDOG	// 교착 상태나 무한 루프(프리즈) 현상을 감지하기 위해 워치독(Watchdog, 감시견) 스레드 추가
+//#define  DEF_USE_LZ4_COMPRESSION			// S2S 번들 LZ4 압축 (lz4 라이브러리 링크 필요, Gateway/GameServer 모두 적용해야 협상됨)
@@ -1,4 +1,6 @@
 ﻿#pragma once
+#include <cstddef>
+#include <cstdint>
 
 // ==========================================
 //   게임 서버 상수 정의
@@ -14,6 +16,13 @@ namespace GameConstants {
         constexpr float WIDTH = 1000.0f;            // 맵 가로 크기
         constexpr float HEIGHT = 1000.0f;           // 맵 세로 크기
         constexpr int SECTOR_SIZE = 50;             // 섹터 크기 (AOI 단위)
+
+        // AOI 거리 기반 갱신 주기(LOD) 기본값 (맵별로 config.json에서 재정의 가능)
+        constexpr float AOI_LOD_NEAR_RADIUS = 30.0f;    // 이 거리 이내: 매 이동마다 전송
+        constexpr float AOI_LOD_MID_RADIUS = 70.0f;     // 이 거리 이내: MID 주기로 전송
+        constexpr uint32_t AOI_LOD_MID_INTERVAL = 2;    // 중거리 관찰자: N번 이동 중 1번 전송
+        constexpr uint32_t AOI_LOD_FAR_INTERVAL = 5;    // 원거리 관찰자: N번 이동 중 1번 전송
+        constexpr uint32_t AOI_LOD_SETTLE_MS = 500;     // 마지막 이동 후 이 시간 동안 멈춰 있으면 건너뛴 관찰자에게 최종 위치 전송
     }
 
     // ---------------------------------------------------------
@@ -55,8 +64,24 @@ namespace GameConstants {
     namespace Network {
         constexpr int MAX_AOI_BROADCAST = 20;           // AOI 브로드캐스트 최대 인원
         constexpr float MONSTER_SYNC_INTERVAL = 2.0f;   // 몬스터 위치 동기화 주기 (초)
-        constexpr int SEND_QUEUE_MAX_SIZE = 100000;     // 전송 큐 최대 크기
+        constexpr int SEND_QUEUE_MAX_SIZE = 100000;     // 전송 큐 최대 크기 (S2S 세션)
+        constexpr size_t CLIENT_SEND_SOFT_BUDGET = 256 * 1024;  // 클라이언트 송신 큐 soft 예산: 초과 시 이동 패킷 드랍
+        constexpr size_t CLIENT_SEND_HARD_BUDGET = 1024 * 1024; // 클라이언트 송신 큐 hard 예산: 초과 시 연결 종료
+        constexpr uint64_t SEND_DROP_LOG_INTERVAL = 1000;       // 이동 패킷 드랍 경고 로그 간격 (드랍 N회마다 1회)
+        constexpr size_t RECV_BATCH_FRAME_RESERVE = 256;        // RecvBatch 프레임 목록 초기 예약 개수
         constexpr int MAX_RETRIES = 3;                  // 네트워크 재시도 횟수
+        constexpr int MAX_GATHER_BUFFERS = 64;          // gather write 1회에 묶을 최대 패킷 수 (WSABUF/iovec 개수)
+        constexpr int MAX_GATHER_BYTES = 64 * 1024;     // gather write 1회에 묶을 최대 바이트 수
+        constexpr size_t CLIENT_RECV_RING_SIZE = 8 * 1024;  // 클라이언트 세션 스트리밍 수신 링 버퍼 크기
+        constexpr size_t S2S_RECV_RING_SIZE = 64 * 1024;    // 서버 간 세션 스트리밍 수신 링 버퍼 크기
+        constexpr size_t S2S_BUNDLE_FLUSH_BYTES = 3 * 1024; // S2S 번들 누적 크기가 이 값 이상이면 즉시 플러시 (번들 최대 MAX_PACKET_SIZE)
+        constexpr size_t S2S_COMPRESS_MIN_BYTES = 512;      // 이 크기 이상인 S2S 번들만 압축 (협상된 링크, DEF_USE_LZ4_COMPRESSION)
+        constexpr int TIMING_WHEEL_TICK_MS = 100;           // 세션 타이머 공용 타이밍 휠 tick 간격 (밀리초)
+        constexpr int CLIENT_IDLE_CHECK_SEC = 30;           // Gateway 클라이언트 유휴 검사 주기 (초)
+        constexpr int CLIENT_IDLE_TIMEOUT_SEC = 180;        // 이 시간 동안 수신이 없으면 Gateway가 연결 종료 (초)
+        constexpr uint32_t SESSION_HANDLE_INDEX_BITS = 24;  // 세션 핸들 하위 비트(세대 + 슬롯 인덱스), 상위 비트는 발급 Gateway ID
+        constexpr uint32_t SESSION_HANDLE_GENERATION_BITS = 4;  // 하위 비트 중 슬롯 재사용 세대 카운터 몫 (나머지가 슬롯 인덱스)
+        constexpr int MAX_GATEWAY_ID = (1 << (32 - SESSION_HANDLE_INDEX_BITS)) - 1;  // 핸들 상위 비트에 담을 수 있는 최대 Gateway ID (0은 무효)
     }
 
     // ---------------------------------------------------------
@@ -25,6 +25,7 @@ namespace StressConstants {
         constexpr float MOVE_RANGE = 5.0f;              // 이동 범위 (-5 ~ +5)
         constexpr float SPAWN_RANGE = 1000.0f;          // 초기 스폰 좌표 범위
         constexpr int MAX_TARGET_CONNECTION = 3000;     // 최대 연결 수
+        constexpr int ACTION_WHEEL_TICK_MS = 50;        // 봇 행동 타이머(타이밍 휠) tick 간격 (밀리초)
     }
 
     // ---------------------------------------------------------
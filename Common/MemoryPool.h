@@ -2,6 +2,12 @@
 #include <vector>
 #include <memory>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
 #include <boost/lockfree/queue.hpp>
 
 // ==========================================
@@ -12,24 +18,87 @@
 //
 // 변경 후: MAX_PACKET_SIZE=4096 (실제 게임 패킷은 대부분 수백 바이트 이내)
 //   → 풀 크기를 서버 역할별로 차등 적용 (Initialize 호출 시 결정)
-//   → GameServer/GatewayServer: 10,000개 × 4KB = 약 40MB
-//   → LoginServer/WorldServer:  1,000개 × 4KB = 약  4MB
+//   → 실제 크기 분포는 아래 사이즈 클래스(PoolConfig::PoolSizing) 참고
 // ==========================================
 constexpr size_t MAX_PACKET_SIZE = 4096;
 
-// 서버 역할별 풀 사전 할당 개수 상수
+// ==========================================
+//   사이즈 클래스 기반 아레나 풀
+//
+// 변경 전: 모든 버퍼가 4KB 고정 (std::vector<char> 개별 힙 할당)
+//   -> 30바이트 이동 패킷도 4KB를 점유 (GameServer/GatewayServer 풀 40MB)
+//   -> 모든 I/O 스레드가 단일 lockfree::queue head에서 경합
+//
+// 변경 후: 64 / 256 / 1K / 4K 네 개의 사이즈 클래스
+//   -> 초기화 시 하나의 연속 아레나를 할당하고 클래스별로 잘라서 사용
+//   -> 아레나 전체를 한 번 memset하여 페이지를 미리 커밋 (런타임 페이지 폴트 제거)
+//   -> Acquire(size)는 size가 들어가는 가장 작은 클래스에서 대여
+//   -> 해당 클래스 고갈 시 상위 클래스 -> 힙 순서로 대체 (동작 보장)
+//   -> 클래스마다 독립 free list를 두어 경합을 크기별로 분산
+//   -> 클래스별 사용량(in_use)/최고 사용량(high_water)/대체 횟수 통계 제공
+// ==========================================
 namespace PoolConfig {
+    constexpr size_t NUM_SIZE_CLASSES = 4;
+    constexpr size_t SIZE_CLASSES[NUM_SIZE_CLASSES] = { 64, 256, 1024, MAX_PACKET_SIZE };
+
+    // 사이즈 클래스별 사전 할당 개수
+    struct PoolSizing {
+        int counts[NUM_SIZE_CLASSES];
+    };
+
     // GameServer/GatewayServer: AOI 브로드캐스트로 동시 전송량이 많음
-    constexpr int HEAVY_SERVER = 10000;
+    //   64B x 16384 + 256B x 8192 + 1KB x 2048 + 4KB x 1024 = 약 9MB
+    //   (이동/공격 패킷은 대부분 64~256B 클래스에 들어감)
+    constexpr PoolSizing HEAVY_SERVER = { { 16384, 8192, 2048, 1024 } };
     // LoginServer/WorldServer: S2S 통신 위주로 동시 전송량이 적음
-    constexpr int LIGHT_SERVER = 1000;
+    //   64B x 2048 + 256B x 1024 + 1KB x 256 + 4KB x 128 = 약 1MB
+    constexpr PoolSizing LIGHT_SERVER = { { 2048, 1024, 256, 128 } };
+
+    // 힙 대체 할당 버퍼 표시용 클래스 인덱스
+    constexpr uint8_t HEAP_CLASS = 0xFF;
+
+    // 스레드 로컬 매거진 설정 (클래스별)
+    constexpr int MAGAZINE_SIZE = 64;       // 스레드당 보관 최대 개수
+    constexpr int MAGAZINE_REFILL = 16;     // 공유 풀에서 한 번에 채워오는 개수
+    constexpr int REMOTE_FREE_BATCH = 32;   // 타 스레드 반납분을 모아서 공유 풀에 돌려주는 단위
+
+    // size가 들어가는 가장 작은 사이즈 클래스 (없으면 NUM_SIZE_CLASSES)
+    inline size_t FindSizeClass(size_t size) {
+        for (size_t i = 0; i < NUM_SIZE_CLASSES; ++i) {
+            if (size <= SIZE_CLASSES[i]) return i;
+        }
+        return NUM_SIZE_CLASSES;
+    }
 }
 
-// 재사용될 고정 크기 버퍼 객체
+// 재사용될 버퍼 객체
+//   아레나 버퍼: data_는 아레나 내부를 가리키며 풀이 수명을 관리
+//   힙 버퍼:     풀 고갈/초과 크기 시 heap_storage_가 메모리를 소유
 struct SendBuffer {
-    std::vector<char> buffer_;
-    SendBuffer(size_t exact_size) { buffer_.resize(exact_size); }
-    SendBuffer() { buffer_.resize(MAX_PACKET_SIZE); }
+    char* data_ = nullptr;
+    uint32_t capacity_ = 0;
+    uint8_t class_index_ = PoolConfig::HEAP_CLASS;
+    uint16_t owner_thread_ = 0;     // 마지막으로 대여한 스레드 (SendBufferPool::LocalThreadId)
+    std::unique_ptr<char[]> heap_storage_;
+
+    SendBuffer() = default;
+    SendBuffer(char* arena_ptr, uint32_t capacity, uint8_t class_index)
+        : data_(arena_ptr), capacity_(capacity), class_index_(class_index) {}
+    explicit SendBuffer(size_t exact_size)
+        : heap_storage_(new char[exact_size]) {
+        data_ = heap_storage_.get();
+        capacity_ = static_cast<uint32_t>(exact_size);
+    }
+
+    SendBuffer(const SendBuffer&) = delete;
+    SendBuffer& operator=(const SendBuffer&) = delete;
+    SendBuffer(SendBuffer&&) = default;
+    SendBuffer& operator=(SendBuffer&&) = default;
+
+    char* Data() { return data_; }
+    const char* Data() const { return data_; }
+    size_t Capacity() const { return capacity_; }
+    bool IsHeap() const { return class_index_ == PoolConfig::HEAP_CLASS; }
 };
 
 // ==========================================
@@ -37,16 +106,121 @@ struct SendBuffer {
 //
 //   지연 초기화(Lazy Init) 방식으로 변경
 //   - 생성자에서 사전 할당하지 않음 (싱글톤 접근만으로 메모리 폭발 방지)
-//   - 서버 main()에서 Initialize(count)를 호출하여 역할에 맞는 크기로 초기화
+//   - 서버 main()에서 Initialize(sizing)를 호출하여 역할에 맞는 크기로 초기화
 //   - Initialize 없이 Acquire 호출 시에도 동적 할당으로 안전하게 동작
+//
+//   스레드 로컬 매거진 캐시
+//
+// 변경 전: 모든 Acquire/Release가 공유 lockfree::queue에 CAS
+//   -> 워커 4개 × 초당 10만+ 패킷에서 queue head 캐시 라인 경합이 프로파일에 노출
+//
+// 변경 후: 공유 풀 앞에 스레드별 매거진(클래스별 스택)을 둠
+//   -> Acquire: 자기 매거진에서 pop (원자 연산 없음)
+//      비어 있으면 공유 풀에서 MAGAZINE_REFILL개를 한 번에 채워옴
+//   -> Release(대여한 스레드와 같음): 자기 매거진에 push
+//      가득 차면 절반을 공유 풀로 반환
+//   -> Release(다른 스레드): 스레드별 원격 반납 배치에 모았다가
+//      REMOTE_FREE_BATCH개 단위로 공유 풀에 반환
+//   -> 적중/공유 풀 보충/힙 할당 횟수를 스레드 로컬로 세고 보충·반환 시점에만 합산
+//
+// in_use/high_water는 공유 풀 기준 (매거진에 보관 중인 버퍼도 사용 중으로 집계)
 // ==========================================
 class SendBufferPool {
 private:
-    boost::lockfree::queue<SendBuffer*> pool_;
+    struct SizeClass {
+        boost::lockfree::queue<SendBuffer*> free_list{ 128 };
+        std::atomic<int> in_use{ 0 };
+        std::atomic<int> high_water{ 0 };
+        std::atomic<uint64_t> fallback_count{ 0 };  // 상위 클래스/힙으로 대체된 횟수
+        int capacity = 0;
+    };
+
+    // 스레드별 캐시 (thread_local, 소유 스레드만 접근)
+    struct ThreadCache {
+        SendBuffer* magazine[PoolConfig::NUM_SIZE_CLASSES][PoolConfig::MAGAZINE_SIZE];
+        int magazine_count[PoolConfig::NUM_SIZE_CLASSES] = {};
+
+        SendBuffer* remote[PoolConfig::NUM_SIZE_CLASSES][PoolConfig::REMOTE_FREE_BATCH];
+        int remote_count[PoolConfig::NUM_SIZE_CLASSES] = {};
+
+        uint64_t pending_hits = 0;
+
+        // 스레드 종료 시 보관 중인 버퍼를 모두 공유 풀로 반환
+        ~ThreadCache() { SendBufferPool::GetInstance().DrainThreadCache(*this); }
+    };
+
+    std::array<SizeClass, PoolConfig::NUM_SIZE_CLASSES> classes_;
+    std::atomic<int> heap_in_use_{ 0 };
+
+    std::atomic<uint64_t> local_hits_{ 0 };       // 매거진 적중
+    std::atomic<uint64_t> shared_refills_{ 0 };   // 매거진 미스 -> 공유 풀 보충
+    std::atomic<uint64_t> remote_flushes_{ 0 };   // 타 스레드 반납 배치 반환
+    std::atomic<uint64_t> heap_allocs_{ 0 };      // new SendBuffer 대체 할당
+
+    inline static std::atomic<uint16_t> s_next_thread_id_{ 1 };
+
+    std::unique_ptr<char[]> arena_;
+    std::vector<SendBuffer> headers_;   // 아레나 조각을 가리키는 버퍼 헤더 (Initialize 후 크기 고정)
+    size_t arena_bytes_ = 0;
     bool initialized_ = false;
 
     //   생성자에서 사전 할당 제거 → Initialize()로 이관
-    SendBufferPool() : pool_(128) {}
+    SendBufferPool() = default;
+
+    static ThreadCache& LocalCache() {
+        thread_local ThreadCache cache;
+        return cache;
+    }
+
+    static uint16_t LocalThreadId() {
+        thread_local uint16_t id = s_next_thread_id_.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    void FlushHits(ThreadCache& cache) {
+        if (cache.pending_hits == 0) return;
+        local_hits_.fetch_add(cache.pending_hits, std::memory_order_relaxed);
+        cache.pending_hits = 0;
+    }
+
+    // 공유 풀에서 최대 MAGAZINE_REFILL개를 꺼내 매거진을 채움
+    int Refill(ThreadCache& cache, size_t class_index) {
+        SizeClass& sc = classes_[class_index];
+        int got = 0;
+        SendBuffer* buf = nullptr;
+        while (got < PoolConfig::MAGAZINE_REFILL && sc.free_list.pop(buf)) {
+            cache.magazine[class_index][cache.magazine_count[class_index]++] = buf;
+            ++got;
+        }
+        if (got == 0) return 0;
+
+        int now = sc.in_use.fetch_add(got, std::memory_order_relaxed) + got;
+        int prev = sc.high_water.load(std::memory_order_relaxed);
+        while (now > prev && !sc.high_water.compare_exchange_weak(prev, now, std::memory_order_relaxed)) {}
+
+        shared_refills_.fetch_add(1, std::memory_order_relaxed);
+        FlushHits(cache);
+        return got;
+    }
+
+    // 버퍼 묶음을 공유 풀로 반환
+    void ReturnToShared(size_t class_index, SendBuffer** bufs, int count) {
+        SizeClass& sc = classes_[class_index];
+        for (int i = 0; i < count; ++i) {
+            sc.free_list.push(bufs[i]);
+        }
+        sc.in_use.fetch_sub(count, std::memory_order_relaxed);
+    }
+
+    void DrainThreadCache(ThreadCache& cache) {
+        for (size_t i = 0; i < PoolConfig::NUM_SIZE_CLASSES; ++i) {
+            ReturnToShared(i, cache.magazine[i], cache.magazine_count[i]);
+            ReturnToShared(i, cache.remote[i], cache.remote_count[i]);
+            cache.magazine_count[i] = 0;
+            cache.remote_count[i] = 0;
+        }
+        FlushHits(cache);
+    }
 
 public:
     static SendBufferPool& GetInstance() {
@@ -55,33 +229,138 @@ public:
     }
 
     //     서버 역할에 맞는 풀 크기로 초기화 (main 시작부에서 1회 호출)
-    void Initialize(int buffer_count) {
+    void Initialize(const PoolConfig::PoolSizing& sizing) {
         if (initialized_) return;
         initialized_ = true;
 
-        for (int i = 0; i < buffer_count; ++i) {
-            pool_.push(new SendBuffer());
+        size_t total_count = 0;
+        arena_bytes_ = 0;
+        for (size_t i = 0; i < PoolConfig::NUM_SIZE_CLASSES; ++i) {
+            total_count += static_cast<size_t>(sizing.counts[i]);
+            arena_bytes_ += static_cast<size_t>(sizing.counts[i]) * PoolConfig::SIZE_CLASSES[i];
+        }
+
+        // 연속 아레나 1회 할당 + 페이지 사전 커밋
+        arena_.reset(new char[arena_bytes_]);
+        std::memset(arena_.get(), 0, arena_bytes_);
+
+        headers_.reserve(total_count);
+        char* cursor = arena_.get();
+        for (size_t i = 0; i < PoolConfig::NUM_SIZE_CLASSES; ++i) {
+            uint32_t class_size = static_cast<uint32_t>(PoolConfig::SIZE_CLASSES[i]);
+            classes_[i].capacity = sizing.counts[i];
+            classes_[i].free_list.reserve(static_cast<size_t>(sizing.counts[i]));
+
+            for (int n = 0; n < sizing.counts[i]; ++n) {
+                headers_.emplace_back(cursor, class_size, static_cast<uint8_t>(i));
+                classes_[i].free_list.push(&headers_.back());
+                cursor += class_size;
+            }
+        }
+
+        std::cout << "[SendBufferPool] 메모리 풀 초기화 완료: 아레나 "
+            << (arena_bytes_ / 1024) << " KB (";
+        for (size_t i = 0; i < PoolConfig::NUM_SIZE_CLASSES; ++i) {
+            std::cout << (i ? ", " : "") << PoolConfig::SIZE_CLASSES[i] << "B x " << sizing.counts[i];
         }
-        std::cout << "[SendBufferPool] 메모리 풀 초기화 완료: "
-            << buffer_count << "개 x " << MAX_PACKET_SIZE
-            << " bytes = 약 " << (static_cast<size_t>(buffer_count) * MAX_PACKET_SIZE / 1024 / 1024) << " MB\n";
+        std::cout << ")\n";
     }
 
-    // 버퍼 대여
-    SendBuffer* Acquire() {
-        SendBuffer* buf = nullptr;
-        if (pool_.pop(buf)) {
-            return buf; // 풀에서 즉시 꺼내줌 (Lock-Free)
+    // 버퍼 대여: size 이상을 담을 수 있는 가장 작은 클래스에서 꺼냄
+    SendBuffer* Acquire(size_t size = MAX_PACKET_SIZE) {
+        size_t first = PoolConfig::FindSizeClass(size);
+        ThreadCache& cache = LocalCache();
+
+        for (size_t i = first; i < PoolConfig::NUM_SIZE_CLASSES; ++i) {
+            // 1) 스레드 로컬 매거진 (원자 연산 없음)
+            // 2) 비어 있으면 공유 풀에서 묶음 보충
+            if (cache.magazine_count[i] > 0) {
+                ++cache.pending_hits;
+            }
+            else if (Refill(cache, i) == 0) {
+                continue;
+            }
+
+            SendBuffer* buf = cache.magazine[i][--cache.magazine_count[i]];
+            buf->owner_thread_ = LocalThreadId();
+            if (i != first) classes_[first].fallback_count.fetch_add(1, std::memory_order_relaxed);
+            return buf;
         }
+
         // 풀이 고갈되었거나 Initialize 전이라면 임시 생성
-        return new SendBuffer();
+        if (first < PoolConfig::NUM_SIZE_CLASSES) {
+            classes_[first].fallback_count.fetch_add(1, std::memory_order_relaxed);
+            size = PoolConfig::SIZE_CLASSES[first];
+        }
+        heap_in_use_.fetch_add(1, std::memory_order_relaxed);
+        heap_allocs_.fetch_add(1, std::memory_order_relaxed);
+        return new SendBuffer(size);
     }
 
     // 버퍼 반납
     void Release(SendBuffer* buf) {
-        if (!pool_.push(buf)) {
-            delete buf; // 풀이 꽉 찼을 때만 예외적으로 삭제
+        if (buf->IsHeap()) {
+            heap_in_use_.fetch_sub(1, std::memory_order_relaxed);
+            delete buf;
+            return;
+        }
+
+        ThreadCache& cache = LocalCache();
+        size_t ci = buf->class_index_;
+
+        // 대여한 스레드에서 반납 -> 자기 매거진으로
+        if (buf->owner_thread_ == LocalThreadId()) {
+            if (cache.magazine_count[ci] == PoolConfig::MAGAZINE_SIZE) {
+                int half = PoolConfig::MAGAZINE_SIZE / 2;
+                cache.magazine_count[ci] -= half;
+                ReturnToShared(ci, &cache.magazine[ci][cache.magazine_count[ci]], half);
+            }
+            cache.magazine[ci][cache.magazine_count[ci]++] = buf;
+            return;
+        }
+
+        // 다른 스레드에서 반납 -> 배치로 모아서 공유 풀로
+        cache.remote[ci][cache.remote_count[ci]++] = buf;
+        if (cache.remote_count[ci] == PoolConfig::REMOTE_FREE_BATCH) {
+            ReturnToShared(ci, cache.remote[ci], cache.remote_count[ci]);
+            cache.remote_count[ci] = 0;
+            remote_flushes_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // 통계 조회 (모니터링용, 근사값)
+    int GetInUse(size_t class_index) const { return classes_[class_index].in_use.load(std::memory_order_relaxed); }
+    int GetHighWater(size_t class_index) const { return classes_[class_index].high_water.load(std::memory_order_relaxed); }
+    int GetCapacity(size_t class_index) const { return classes_[class_index].capacity; }
+    uint64_t GetFallbackCount(size_t class_index) const { return classes_[class_index].fallback_count.load(std::memory_order_relaxed); }
+    int GetHeapInUse() const { return heap_in_use_.load(std::memory_order_relaxed); }
+    size_t GetArenaBytes() const { return arena_bytes_; }
+
+    uint64_t GetLocalHits() const { return local_hits_.load(std::memory_order_relaxed); }
+    uint64_t GetSharedRefills() const { return shared_refills_.load(std::memory_order_relaxed); }
+    uint64_t GetRemoteFlushes() const { return remote_flushes_.load(std::memory_order_relaxed); }
+    uint64_t GetHeapAllocs() const { return heap_allocs_.load(std::memory_order_relaxed); }
+
+    // 매거진 적중률 (%) - 적중 / (적중 + 공유 풀 보충)
+    double GetLocalHitRate() const {
+        uint64_t hits = GetLocalHits();
+        uint64_t refills = GetSharedRefills();
+        if (hits + refills == 0) return 0.0;
+        return 100.0 * static_cast<double>(hits) / static_cast<double>(hits + refills);
+    }
+
+    // 클래스별 "사용중/최고/용량" 요약 문자열 (워치독 로그용)
+    std::string FormatStats() const {
+        std::ostringstream oss;
+        for (size_t i = 0; i < PoolConfig::NUM_SIZE_CLASSES; ++i) {
+            oss << (i ? " " : "") << PoolConfig::SIZE_CLASSES[i] << "B:"
+                << GetInUse(i) << "/" << GetHighWater(i) << "/" << GetCapacity(i);
         }
+        oss << " heap:" << GetHeapInUse()
+            << " 로컬적중:" << static_cast<int>(GetLocalHitRate()) << "%"
+            << " 공유보충:" << GetSharedRefills()
+            << " 힙할당:" << GetHeapAllocs();
+        return oss.str();
     }
 };
 
@@ -0,0 +1,121 @@
+﻿#pragma once
+#include <boost/asio.hpp>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <iostream>
+
+// ==========================================
+//   코어당 io_context 풀 (thread-per-core 모드)
+//
+// [변경 전 문제]
+//   서버마다 io_context 1개를 N개 스레드가 함께 run()
+//   -> 한 세션의 완료 핸들러가 매번 다른 코어에서 실행되어 세션 상태가 캐시에서 밀려남
+//   -> 모든 스레드가 하나의 리액터/완료 큐를 두고 경쟁
+//
+// [변경 후]
+//   코어 수만큼 io_context를 만들고 각각 전용 스레드 1개가 run()
+//   -> 세션은 accept된 io_context에 고정 (세션 strand가 소켓 executor에서 생성되므로 자동)
+//   -> 다른 코어의 세션에 대한 작업은 기존처럼 해당 세션 strand로 post (메시지 전달)
+//
+// [accept 분배]
+//   Linux(SO_REUSEPORT): 코어마다 같은 포트에 acceptor를 열고 커널이 연결을 분산
+//   그 외(Windows 등):   acceptor 1개가 GetNext()로 고른 io_context에 소켓을 생성하여 accept
+//   (Windows의 SO_REUSEADDR은 포트 가로채기를 허용하므로 대체재로 쓰지 않음)
+//
+// [사용 예]
+//   IoContextPool pool(4);
+//   acceptor.async_accept(pool.GetNext(), handler);   // 소켓이 해당 코어에 고정
+//   pool.Run();                                        // 코어별 스레드 가동 (논블로킹)
+//   pool.Join();
+// ==========================================
+class IoContextPool {
+private:
+    using WorkGuard = boost::asio::executor_work_guard<boost::asio::io_context::executor_type>;
+
+    std::vector<std::unique_ptr<boost::asio::io_context>> contexts_;
+    std::vector<WorkGuard> work_guards_;
+    std::vector<std::thread> threads_;
+    std::atomic<size_t> next_{ 0 };
+
+public:
+    explicit IoContextPool(size_t count) {
+        if (count == 0) count = 1;
+        contexts_.reserve(count);
+        work_guards_.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            // concurrency_hint 1: 전용 스레드 1개만 run()하므로 내부 락 최소화
+            contexts_.push_back(std::make_unique<boost::asio::io_context>(1));
+            work_guards_.push_back(boost::asio::make_work_guard(*contexts_.back()));
+        }
+    }
+
+    IoContextPool(const IoContextPool&) = delete;
+    IoContextPool& operator=(const IoContextPool&) = delete;
+
+    ~IoContextPool() {
+        Stop();
+        Join();
+    }
+
+    size_t Size() const { return contexts_.size(); }
+    boost::asio::io_context& Get(size_t index) { return *contexts_[index % contexts_.size()]; }
+
+    // 라운드 로빈으로 다음 io_context 선택 (accept 분배용)
+    boost::asio::io_context& GetNext() {
+        size_t index = next_.fetch_add(1, std::memory_order_relaxed) % contexts_.size();
+        return *contexts_[index];
+    }
+
+    void Run() {
+        for (size_t i = 0; i < contexts_.size(); ++i) {
+            threads_.emplace_back([ctx = contexts_[i].get()]() { ctx->run(); });
+        }
+    }
+
+    void Join() {
+        for (auto& t : threads_) {
+            if (t.joinable()) t.join();
+        }
+        threads_.clear();
+    }
+
+    void Stop() {
+        work_guards_.clear();
+        for (auto& ctx : contexts_) ctx->stop();
+    }
+};
+
+// ==========================================
+//   SO_REUSEPORT 지원 여부
+//
+// 지원 플랫폼에서는 코어마다 같은 포트로 acceptor를 열 수 있습니다.
+// 미지원 플랫폼에서는 OpenAcceptor가 reuse_port를 무시합니다. (호출 측은 단일 acceptor로 분배)
+// ==========================================
+namespace IoContextPoolUtil {
+
+#if defined(SO_REUSEPORT)
+    constexpr bool HAS_REUSE_PORT = true;
+    using ReusePort = boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+#else
+    constexpr bool HAS_REUSE_PORT = false;
+#endif
+
+    inline boost::asio::ip::tcp::acceptor OpenAcceptor(boost::asio::io_context& io_context, short port, bool reuse_port) {
+        using boost::asio::ip::tcp;
+        tcp::endpoint endpoint(tcp::v4(), port);
+        tcp::acceptor acceptor(io_context);
+        acceptor.open(endpoint.protocol());
+        acceptor.set_option(tcp::acceptor::reuse_address(true));
+#if defined(SO_REUSEPORT)
+        if (reuse_port) acceptor.set_option(ReusePort(true));
+#else
+        (void)reuse_port;
+#endif
+        acceptor.bind(endpoint);
+        acceptor.listen();
+        return acceptor;
+    }
+
+} // namespace IoContextPoolUtil
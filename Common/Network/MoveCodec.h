@@ -0,0 +1,245 @@
+﻿#pragma once
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+// ==========================================
+//   압축 이동 코덱 (Client <-> Gateway, 접속 시 협상)
+//
+// [변경 전 문제]
+//   MoveRes = account_id 문자열 + float x/y/z/yaw (protobuf)
+//   -> 이동 1건당 페이로드 30~40바이트, 클라이언트 대역폭의 대부분을 차지
+//
+// [변경 후] GatewayConnectReq/Res.move_codec_flags로 FLAG_COMPACT_MOVE가 협상된 세션만
+//   1. 좌표를 1/QUANT_PER_UNIT 격자로 양자화(int32), yaw는 1바이트(256분할)로 압축
+//   2. 엔티티는 account_id 대신 세션 핸들의 슬롯(하위 20비트, Gateway 접두어/세대 제외)으로 식별
+//      (Gateway가 자기가 발급한 핸들만 슬롯으로 변환, 다른 Gateway 소속 이동은 기존 MoveRes)
+//   3. 관찰자(수신 세션)별로 엔티티마다 키프레임을 두고 이후 이동은 키프레임 대비 델타로 전송
+//      - 키프레임(MOVE_KEYFRAME, protobuf): 절대 양자화 좌표 (+처음 보는 엔티티면 account_id)
+//        드랍 불가 레인(CHAT)으로 적재 -> 드랍/대체되지 않으므로 수신 측이 반드시 받은 기준값이 됨
+//        (델타보다 상위 레인이므로 대기 중인 이전 기준 델타는 적재 시 무효화)
+//      - 델타(MOVE_DELTA, 바이너리): [entity varint][dx][dy][dz zigzag varint][yaw u8]
+//        MOVEMENT로 적재 -> 느린 세션에서 이전 델타를 대체/드랍해도 각 델타가 독립적으로 복원됨
+//        (직전 델타가 아니라 키프레임 대비이므로 "마지막으로 받은 값"이 보장된 기준)
+//   4. 델타가 MAX_DELTA를 넘거나 KEYFRAME_INTERVAL회 누적되면 새 키프레임 발급
+//   -> 델타 페이로드 = 엔티티 varint(슬롯 2^14 미만이면 1~2바이트, 최대 3바이트)
+//      + 축당 1~2바이트 × 3 + yaw 1바이트 = 일반적으로 5~8바이트
+//   5. 관찰자별 기준값은 MAX_BASELINES개까지만 유지 (초과 시 오래 안 본 절반 제거)
+//      -> 제거된 엔티티는 다음 이동이 account_id 포함 키프레임으로 나가므로 정합성 유지
+//      -> 클라이언트 복원 상태도 MAX_CLIENT_KEYFRAMES개까지만 유지 (같은 방식으로 제거)
+//         서버가 아직 기준값을 가진 엔티티를 먼저 지우지 않도록 상한을 서버의 2배로 둠
+//
+// 엔티티 핸들이 없는 이동(몬스터 등)과 협상하지 않은 클라이언트는 기존 MoveRes를 그대로 사용
+// ==========================================
+namespace MoveCodec {
+
+    constexpr uint32_t FLAG_COMPACT_MOVE = 1u << 0;
+
+    constexpr float QUANT_PER_UNIT = 16.0f;         // 1/16 유닛 격자 (약 6cm)
+    constexpr int32_t MAX_DELTA = 4095;              // zigzag varint 2바이트 이내
+    constexpr uint16_t KEYFRAME_INTERVAL = 32;       // 키프레임 1개당 최대 델타 수
+    constexpr size_t MAX_BASELINES = 512;            // 관찰자 1명이 기준값을 유지하는 엔티티 수 상한
+    constexpr size_t MAX_CLIENT_KEYFRAMES = MAX_BASELINES * 2;  // 클라이언트 복원 상태 상한 (서버 기준값보다 넉넉히)
+    constexpr size_t MAX_DELTA_PAYLOAD = 5 + 5 * 3 + 1;
+
+    inline int32_t Quantize(float v) { return static_cast<int32_t>(std::lround(v * QUANT_PER_UNIT)); }
+    inline float Dequantize(int32_t q) { return static_cast<float>(q) / QUANT_PER_UNIT; }
+
+    // yaw(도) -> 1바이트 (약 1.4도 단위)
+    inline uint8_t PackYaw(float yaw_deg) {
+        float turns = yaw_deg / 360.0f;
+        turns -= std::floor(turns);
+        return static_cast<uint8_t>(static_cast<int>(std::lround(turns * 256.0f)) & 0xFF);
+    }
+    inline float UnpackYaw(uint8_t yaw) { return static_cast<float>(yaw) * (360.0f / 256.0f); }
+
+    inline uint32_t ZigZag(int32_t v) { return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31); }
+    inline int32_t UnZigZag(uint32_t v) { return static_cast<int32_t>(v >> 1) ^ -static_cast<int32_t>(v & 1); }
+
+    inline char* WriteVarint(char* out, uint32_t v) {
+        while (v >= 0x80) {
+            *out++ = static_cast<char>((v & 0x7F) | 0x80);
+            v >>= 7;
+        }
+        *out++ = static_cast<char>(v);
+        return out;
+    }
+
+    inline bool ReadVarint(const char*& in, const char* end, uint32_t& v) {
+        v = 0;
+        for (int shift = 0; shift <= 28; shift += 7) {
+            if (in >= end) return false;
+            uint8_t byte = static_cast<uint8_t>(*in++);
+            v |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) return true;
+        }
+        return false;
+    }
+
+    // last_used가 오래된 절반을 한 번에 제거 (새 엔티티 삽입마다 스캔하지 않도록)
+    //   -> Map의 값 타입은 uint32_t last_used 멤버를 가져야 함
+    template <typename Map>
+    inline void EvictLeastRecentHalf(Map& entries, uint32_t use_clock, std::vector<uint32_t>& scratch) {
+        scratch.clear();
+        for (const auto& kv : entries) scratch.push_back(use_clock - kv.second.last_used);
+        auto mid = scratch.begin() + scratch.size() / 2;
+        std::nth_element(scratch.begin(), mid, scratch.end(), std::greater<uint32_t>());
+        uint32_t min_age = *mid;
+
+        for (auto it = entries.begin(); it != entries.end();) {
+            if (use_clock - it->second.last_used >= min_age) it = entries.erase(it);
+            else ++it;
+        }
+    }
+
+    struct QuantizedMove {
+        int32_t qx = 0, qy = 0, qz = 0;
+        uint8_t yaw = 0;
+
+        static QuantizedMove From(float x, float y, float z, float yaw_deg) {
+            return { Quantize(x), Quantize(y), Quantize(z), PackYaw(yaw_deg) };
+        }
+    };
+
+    // 델타 페이로드 작성, 반환값: 기록한 바이트 수 (out은 MAX_DELTA_PAYLOAD 이상)
+    inline size_t EncodeDelta(char* out, uint32_t entity, int32_t dx, int32_t dy, int32_t dz, uint8_t yaw) {
+        char* p = out;
+        p = WriteVarint(p, entity);
+        p = WriteVarint(p, ZigZag(dx));
+        p = WriteVarint(p, ZigZag(dy));
+        p = WriteVarint(p, ZigZag(dz));
+        *p++ = static_cast<char>(yaw);
+        return static_cast<size_t>(p - out);
+    }
+
+    inline bool DecodeDelta(const char* data, size_t size, uint32_t& entity, int32_t& dx, int32_t& dy, int32_t& dz, uint8_t& yaw) {
+        const char* p = data;
+        const char* end = data + size;
+        uint32_t zx, zy, zz;
+        if (!ReadVarint(p, end, entity) || !ReadVarint(p, end, zx) ||
+            !ReadVarint(p, end, zy) || !ReadVarint(p, end, zz) || p >= end) {
+            return false;
+        }
+        yaw = static_cast<uint8_t>(*p++);
+        dx = UnZigZag(zx); dy = UnZigZag(zy); dz = UnZigZag(zz);
+        return p == end;
+    }
+
+    // ==========================================
+    //   관찰자별 인코더 상태 (Gateway, ClientSession strand 전용)
+    // ==========================================
+    class ObserverEncoder {
+    public:
+        enum class Kind : uint8_t { KEYFRAME, DELTA };
+
+        struct Result {
+            Kind kind;
+            bool include_account_id;    // KEYFRAME일 때 엔티티-계정 매핑을 함께 보낼지
+            int32_t dx, dy, dz;         // DELTA일 때 키프레임 대비 차이
+        };
+
+    private:
+        struct Baseline {
+            int32_t qx, qy, qz;
+            uint64_t account_hash;      // 핸들 슬롯 재사용 감지용
+            uint16_t deltas;            // 현재 키프레임 이후 보낸 델타 수
+            uint32_t last_used;         // 마지막 Encode 시점 (use_clock_)
+        };
+        std::unordered_map<uint32_t, Baseline> baselines_;
+        uint32_t use_clock_ = 0;
+        std::vector<uint32_t> evict_scratch_;   // 제거 기준 계산용 (용량 재사용)
+
+        static bool InRange(int32_t d) { return d >= -MAX_DELTA && d <= MAX_DELTA; }
+
+    public:
+        Result Encode(uint32_t entity, uint64_t account_hash, const QuantizedMove& move) {
+            ++use_clock_;
+            auto it = baselines_.find(entity);
+            if (it == baselines_.end() || it->second.account_hash != account_hash) {
+                if (it == baselines_.end() && baselines_.size() >= MAX_BASELINES) {
+                    EvictLeastRecentHalf(baselines_, use_clock_, evict_scratch_);
+                }
+                baselines_[entity] = { move.qx, move.qy, move.qz, account_hash, 0, use_clock_ };
+                return { Kind::KEYFRAME, true, 0, 0, 0 };
+            }
+
+            Baseline& base = it->second;
+            base.last_used = use_clock_;
+            int32_t dx = move.qx - base.qx;
+            int32_t dy = move.qy - base.qy;
+            int32_t dz = move.qz - base.qz;
+
+            if (base.deltas >= KEYFRAME_INTERVAL || !InRange(dx) || !InRange(dy) || !InRange(dz)) {
+                base = { move.qx, move.qy, move.qz, account_hash, 0, use_clock_ };
+                return { Kind::KEYFRAME, false, 0, 0, 0 };
+            }
+
+            ++base.deltas;
+            return { Kind::DELTA, false, dx, dy, dz };
+        }
+
+        void Clear() { baselines_.clear(); }
+        size_t Size() const { return baselines_.size(); }
+    };
+
+    // ==========================================
+    //   클라이언트 측 복원 상태 (DummyClient 등)
+    // ==========================================
+    class ClientDecoder {
+    public:
+        struct Move {
+            std::string account_id;
+            float x, y, z, yaw;
+        };
+
+    private:
+        struct Keyframe {
+            std::string account_id;
+            int32_t qx, qy, qz;
+            uint32_t last_used;         // 마지막 복원 시점 (use_clock_)
+        };
+        std::unordered_map<uint32_t, Keyframe> keyframes_;
+        uint32_t use_clock_ = 0;
+        std::vector<uint32_t> evict_scratch_;   // 제거 기준 계산용 (용량 재사용)
+
+    public:
+        // account_id가 비어 있으면 기존 매핑 유지 (위치 기준값만 갱신)
+        bool OnKeyframe(uint32_t entity, const std::string& account_id, int32_t qx, int32_t qy, int32_t qz, uint8_t yaw, Move& out) {
+            ++use_clock_;
+            auto it = keyframes_.find(entity);
+            if (it == keyframes_.end()) {
+                if (account_id.empty()) return false;   // 매핑 없는 키프레임은 복원 불가
+                if (keyframes_.size() >= MAX_CLIENT_KEYFRAMES) {
+                    EvictLeastRecentHalf(keyframes_, use_clock_, evict_scratch_);
+                }
+                it = keyframes_.emplace(entity, Keyframe{}).first;
+            }
+
+            Keyframe& key = it->second;
+            if (!account_id.empty()) key.account_id = account_id;
+            key.qx = qx; key.qy = qy; key.qz = qz;
+            key.last_used = use_clock_;
+            out = { key.account_id, Dequantize(qx), Dequantize(qy), Dequantize(qz), UnpackYaw(yaw) };
+            return true;
+        }
+
+        bool OnDelta(const char* data, size_t size, Move& out) {
+            uint32_t entity; int32_t dx, dy, dz; uint8_t yaw;
+            if (!DecodeDelta(data, size, entity, dx, dy, dz, yaw)) return false;
+
+            auto it = keyframes_.find(entity);
+            if (it == keyframes_.end()) return false;
+
+            Keyframe& key = it->second;
+            key.last_used = ++use_clock_;
+            out = { key.account_id, Dequantize(key.qx + dx), Dequantize(key.qy + dy), Dequantize(key.qz + dz), UnpackYaw(yaw) };
+            return true;
+        }
+    };
+
+} // namespace MoveCodec
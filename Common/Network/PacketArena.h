@@ -0,0 +1,78 @@
+﻿#pragma once
+#include <google/protobuf/arena.h>
+#include <cstddef>
+#include <cstdint>
+
+// ==========================================
+//   PacketArena - 스레드별 protobuf Arena (수신 배치 단위 재사용)
+//
+// [변경 전 문제]
+//   핸들러마다 make_shared<Protocol::...>() 또는 스택 메시지 + ParseFromArray
+//   -> 패킷 1개당 메시지 객체와 문자열 필드(account_id, msg 등)가 각각 힙 할당/해제
+//   -> 이동/공격처럼 초당 수만 건 들어오는 S2S 경로에서 할당자 경합
+//
+// [변경 후]
+//   I/O 스레드마다 Arena 1개(thread_local)를 두고 요청 메시지를 Arena에 생성
+//   -> 메시지와 문자열은 Arena 블록에 범프 할당, 개별 해제 없음
+//   -> 수신 배치 1개를 다 처리하면 Reset() 1회로 일괄 회수
+//   -> 첫 블록은 thread_local 고정 버퍼를 사용하므로 Reset 후에도 힙으로 돌아가지 않음
+//      (배치가 커서 첫 블록을 넘으면 추가 블록만 할당되고 Reset 때 해제)
+//
+// [사용 규칙]
+//   1. 수신 루프에서 배치 처리 전후로 BatchScope를 연다 (PacketDispatcher::Invoke도 연다)
+//      -> 중첩 스코프는 깊이만 세고, 가장 바깥 스코프가 닫힐 때 Reset
+//   2. 핸들러는 Create<T>()로 받은 포인터를 그 핸들러 안에서만 사용
+//      -> 다른 스레드/strand로 post할 때는 필요한 필드를 값으로 복사해서 캡처
+//      -> Arena 메시지를 shared_ptr로 감싸거나 캡처하면 Reset 뒤 댕글링
+// ==========================================
+class PacketArena {
+public:
+    // 스레드당 첫 블록 크기 (일반적인 수신 배치 1개분의 파싱 결과가 들어가는 정도)
+    static constexpr size_t INITIAL_BLOCK_BYTES = 16 * 1024;
+
+private:
+    struct ThreadState {
+        alignas(8) char initial_block[INITIAL_BLOCK_BYTES];
+        google::protobuf::Arena arena;
+        uint32_t depth = 0;
+
+        ThreadState() : arena(MakeOptions(initial_block)) {}
+
+        static google::protobuf::ArenaOptions MakeOptions(char* block) {
+            google::protobuf::ArenaOptions options;
+            options.initial_block = block;
+            options.initial_block_size = INITIAL_BLOCK_BYTES;
+            return options;
+        }
+    };
+
+    static ThreadState& State() {
+        thread_local ThreadState state;
+        return state;
+    }
+
+public:
+    // 수신 배치 1개의 수명 (가장 바깥 스코프가 닫힐 때 현재 스레드 Arena 일괄 회수)
+    class BatchScope {
+    public:
+        BatchScope() { ++State().depth; }
+        ~BatchScope() {
+            ThreadState& state = State();
+            if (--state.depth == 0) state.arena.Reset();
+        }
+
+        BatchScope(const BatchScope&) = delete;
+        BatchScope& operator=(const BatchScope&) = delete;
+    };
+
+    // 현재 스레드 Arena에 메시지 생성 (BatchScope 안에서만 유효)
+    template <typename T>
+    static T* Create() {
+        return google::protobuf::Arena::CreateMessage<T>(&State().arena);
+    }
+
+    // 현재 스레드 Arena가 사용 중인 바이트 수 (디버깅용)
+    static uint64_t SpaceUsed() {
+        return State().arena.SpaceUsed();
+    }
+};
@@ -1,6 +1,9 @@
 ﻿#pragma once
 #include <cstdint>
 #include <cstring>
+#include <cstddef>
+#include <array>
+#include <boost/asio/buffer.hpp>
 #include "../MemoryPool.h"
 
 // ==========================================
@@ -64,3 +67,149 @@ public:
     PacketAssembler(const PacketAssembler&) = delete;
     PacketAssembler& operator=(const PacketAssembler&) = delete;
 };
+
+// ==========================================
+//   스트리밍 수신 모드 (PacketStreamAssembler)
+//
+// [변경 전 문제]
+//   PacketAssembler + async_read(헤더 4B) -> async_read(페이로드) 2단계 수신
+//   -> 패킷 1개당 최소 2회의 recv syscall + 2회의 완료 핸들러
+//   -> 소켓 버퍼에 패킷 수십 개가 이미 도착해 있어도 하나씩 꺼내게 됨
+//
+// [변경 후]
+//   링 버퍼 + async_read_some으로 "받을 수 있는 만큼" 한 번에 수신
+//   -> 한 번의 wakeup에서 완성된 프레임을 모두 꺼내 처리 (PeekFrame/ConsumeFrame 반복)
+//   -> 링 끝에 걸쳐 나뉜 프레임만 선형 버퍼(linear_)에 복사하여 연속 메모리로 제공
+//   -> 링 크기는 세션 종류별로 템플릿 인자로 지정 (클라이언트는 작게, S2S는 크게)
+//
+// [사용 예]
+//   PacketStreamAssembler<8192> stream_;
+//   socket_.async_read_some(stream_.GetWriteBuffers(), [](ec, n) {
+//       stream_.CommitWrite(n);
+//       PacketFrame frame;
+//       while (stream_.PeekFrame(frame) == FrameResult::COMPLETE) {
+//           Dispatch(frame.id, frame.payload, frame.payload_size);
+//           stream_.ConsumeFrame(frame);
+//       }
+//   });
+//
+// [주의]
+//   PeekFrame()이 돌려준 payload 포인터는 ConsumeFrame() 또는 다음 수신 전까지만 유효합니다.
+// ==========================================
+
+struct PacketFrame {
+    uint16_t size = 0;          // 헤더 포함 전체 크기 (PacketHeader.size)
+    uint16_t id = 0;            // 패킷 ID (PacketHeader.id)
+    char* payload = nullptr;    // 페이로드 시작 주소 (payload_size == 0이면 nullptr)
+    uint16_t payload_size = 0;
+};
+
+enum class FrameResult {
+    COMPLETE,       // 완성된 프레임 1개를 꺼냄
+    INCOMPLETE,     // 데이터가 더 필요함
+    INVALID,        // 헤더 크기 위반 -> 연결 종료 대상
+};
+
+template <size_t RingSize>
+class PacketStreamAssembler {
+    static_assert((RingSize & (RingSize - 1)) == 0, "RingSize는 2의 거듭제곱이어야 합니다.");
+    static_assert(RingSize >= MAX_PACKET_SIZE, "RingSize는 최소 MAX_PACKET_SIZE 이상이어야 합니다.");
+
+public:
+    static constexpr size_t HEADER_SIZE = sizeof(uint16_t) * 2;
+
+private:
+    static constexpr size_t MASK = RingSize - 1;
+
+    alignas(64) char ring_[RingSize];
+
+    // 링 경계에 걸친 프레임을 이어붙이는 선형 버퍼
+    alignas(64) char linear_[MAX_PACKET_SIZE];
+
+    // 단조 증가 위치 (실제 인덱스는 & MASK)
+    size_t read_pos_ = 0;
+    size_t write_pos_ = 0;
+
+    void CopyOut(size_t pos, char* dst, size_t len) const {
+        size_t offset = pos & MASK;
+        size_t first = (len < RingSize - offset) ? len : RingSize - offset;
+        std::memcpy(dst, ring_ + offset, first);
+        if (first < len) {
+            std::memcpy(dst + first, ring_, len - first);
+        }
+    }
+
+public:
+    PacketStreamAssembler() = default;
+
+    size_t GetReadableSize() const { return write_pos_ - read_pos_; }
+    size_t GetFreeSize() const { return RingSize - GetReadableSize(); }
+
+    // async_read_some에 전달할 빈 공간 (링 끝에서 나뉘면 최대 2조각)
+    std::array<boost::asio::mutable_buffer, 2> GetWriteBuffers() {
+        size_t free_size = GetFreeSize();
+        size_t offset = write_pos_ & MASK;
+        size_t first = (free_size < RingSize - offset) ? free_size : RingSize - offset;
+
+        return {
+            boost::asio::mutable_buffer(ring_ + offset, first),
+            boost::asio::mutable_buffer(ring_, free_size - first)
+        };
+    }
+
+    // async_read_some 완료 후 수신한 바이트 수 반영
+    void CommitWrite(size_t bytes) { write_pos_ += bytes; }
+
+    // 완성된 프레임이 있으면 꺼내서 frame에 채움 (소비는 ConsumeFrame에서)
+    FrameResult PeekFrame(PacketFrame& frame) {
+        size_t readable = GetReadableSize();
+        if (readable < HEADER_SIZE) return FrameResult::INCOMPLETE;
+
+        char header[HEADER_SIZE];
+        CopyOut(read_pos_, header, HEADER_SIZE);
+        std::memcpy(&frame.size, header, sizeof(uint16_t));
+        std::memcpy(&frame.id, header + sizeof(uint16_t), sizeof(uint16_t));
+
+        if (frame.size < HEADER_SIZE || frame.size > MAX_PACKET_SIZE) {
+            return FrameResult::INVALID;
+        }
+        if (readable < frame.size) return FrameResult::INCOMPLETE;
+
+        frame.payload_size = static_cast<uint16_t>(frame.size - HEADER_SIZE);
+        if (frame.payload_size == 0) {
+            frame.payload = nullptr;
+            return FrameResult::COMPLETE;
+        }
+
+        size_t payload_pos = read_pos_ + HEADER_SIZE;
+        size_t offset = payload_pos & MASK;
+        if (offset + frame.payload_size <= RingSize) {
+            frame.payload = ring_ + offset;
+        }
+        else {
+            // 링 끝에 걸친 프레임만 선형 버퍼로 복사
+            CopyOut(payload_pos, linear_, frame.payload_size);
+            frame.payload = linear_;
+        }
+        return FrameResult::COMPLETE;
+    }
+
+    void ConsumeFrame(const PacketFrame& frame) {
+        read_pos_ += frame.size;
+
+        // 비었으면 위치를 되감아 다음 수신이 링 앞쪽부터 연속으로 쌓이도록 함
+        if (read_pos_ == write_pos_) {
+            read_pos_ = 0;
+            write_pos_ = 0;
+        }
+    }
+
+    void Reset() {
+        read_pos_ = 0;
+        write_pos_ = 0;
+    }
+
+    // 복사/이동 금지 (세션에 1:1 귀속)
+    PacketStreamAssembler(const PacketStreamAssembler&) = delete;
+    PacketStreamAssembler& operator=(const PacketStreamAssembler&) = delete;
+};
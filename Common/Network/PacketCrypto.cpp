@@ -101,8 +101,23 @@ bool PacketCrypto::InitializeWithPassphrase(const std::string& passphrase) {
 }
 
 CryptoResult PacketCrypto::Encrypt(const char* plaintext, uint16_t size) {
+    std::vector<char> output(CryptoConstants::GetEncryptedSize(size));
+
+    size_t written = EncryptInto(plaintext, size, output.data(), output.size());
+    if (written == 0) {
+        return CryptoResult::Failure("Encryption failed (not initialized, empty payload or BCrypt error)");
+    }
+
+    output.resize(written);
+    return CryptoResult::Success(std::move(output));
+}
+
+size_t PacketCrypto::EncryptInto(const char* plaintext, uint16_t size, char* out, size_t out_capacity) {
     if (!initialized_ || !hKey_ || size == 0) {
-        return CryptoResult::Failure("Crypto not initialized or empty payload");
+        return 0;
+    }
+    if (out_capacity < CryptoConstants::GetEncryptedSize(size)) {
+        return 0;
     }
 
     UTILITY::LockGuard lock(crypto_mutex_);
@@ -113,66 +128,57 @@ CryptoResult PacketCrypto::Encrypt(const char* plaintext, uint16_t size) {
     // 2. 랜덤 IV 생성
     unsigned char iv[CryptoConstants::IV_SIZE];
     if (!GenerateRandomIV(iv, CryptoConstants::IV_SIZE)) {
-        return CryptoResult::Failure("IV generation failed");
+        return 0;
     }
 
-    // IV를 복사 (BCryptEncrypt가 IV를 변경하므로)
-    unsigned char iv_copy[CryptoConstants::IV_SIZE];
-    std::memcpy(iv_copy, iv, CryptoConstants::IV_SIZE);
+    // 3. [SeqNum][IV] 기록
+    //    제자리 암호화 시 평문은 out + CRYPTO_HEADER_SIZE부터 시작하므로 덮어쓰지 않음
+    std::memcpy(out, &seq, CryptoConstants::SEQUENCE_NUM_SIZE);
+    std::memcpy(out + CryptoConstants::SEQUENCE_NUM_SIZE, iv, CryptoConstants::IV_SIZE);
 
-    // 3. 암호화 출력 크기 계산
-    ULONG cipher_size = 0;
+    // 4. 암호화 실행 (BCryptEncrypt는 입력/출력 버퍼가 같아도 동작)
+    //    출력 크기는 GetEncryptedSize()로 미리 알고 있으므로 크기 조회 호출 생략
+    char* cipher_out = out + CryptoConstants::CRYPTO_HEADER_SIZE;
+    ULONG cipher_capacity = static_cast<ULONG>(out_capacity - CryptoConstants::CRYPTO_HEADER_SIZE);
+
+    ULONG result_size = 0;
     NTSTATUS status = BCryptEncrypt(
         static_cast<BCRYPT_KEY_HANDLE>(hKey_),
         (PUCHAR)plaintext, size,
-        nullptr, iv_copy, CryptoConstants::IV_SIZE,
-        nullptr, 0, &cipher_size,
+        nullptr, iv, CryptoConstants::IV_SIZE,
+        (PUCHAR)cipher_out, cipher_capacity, &result_size,
         BCRYPT_BLOCK_PADDING);
+
     if (!NT_SUCCESS(status)) {
-        return CryptoResult::Failure("BCryptEncrypt size calculation failed");
+        return 0;
     }
 
-    // 4. 출력 버퍼 할당: [SeqNum(4)][IV(16)][CipherText]
-    size_t total_size = CryptoConstants::SEQUENCE_NUM_SIZE + CryptoConstants::IV_SIZE + cipher_size;
-    std::vector<char> output(total_size);
-
-    // 시퀀스 번호 기록
-    std::memcpy(output.data(), &seq, CryptoConstants::SEQUENCE_NUM_SIZE);
-
-    // IV 기록 (암호화 전의 원본 IV)
-    std::memcpy(output.data() + CryptoConstants::SEQUENCE_NUM_SIZE, iv, CryptoConstants::IV_SIZE);
-
-    // 5. 암호화 실행
-    // IV를 다시 복사 (BCryptEncrypt가 변경하므로)
-    std::memcpy(iv_copy, iv, CryptoConstants::IV_SIZE);
+    return CryptoConstants::CRYPTO_HEADER_SIZE + result_size;
+}
 
-    ULONG result_size = 0;
-    status = BCryptEncrypt(
-        static_cast<BCRYPT_KEY_HANDLE>(hKey_),
-        (PUCHAR)plaintext, size,
-        nullptr, iv_copy, CryptoConstants::IV_SIZE,
-        (PUCHAR)(output.data() + CryptoConstants::SEQUENCE_NUM_SIZE + CryptoConstants::IV_SIZE),
-        cipher_size, &result_size,
-        BCRYPT_BLOCK_PADDING);
+CryptoResult PacketCrypto::Decrypt(const char* ciphertext, uint16_t size) {
+    // 입력을 복사한 뒤 제자리 복호화 -> 앞쪽 [SeqNum][IV]를 잘라내 평문만 남김
+    std::vector<char> output(ciphertext, ciphertext + size);
 
-    if (!NT_SUCCESS(status)) {
-        return CryptoResult::Failure("BCryptEncrypt failed");
+    CryptoSpan span = DecryptInPlace(output.data(), size);
+    if (!span.success) {
+        return CryptoResult::Failure(span.error_message);
     }
 
-    // 실제 암호화된 크기로 조정
-    output.resize(CryptoConstants::SEQUENCE_NUM_SIZE + CryptoConstants::IV_SIZE + result_size);
+    output.erase(output.begin(), output.begin() + CryptoConstants::CRYPTO_HEADER_SIZE);
+    output.resize(span.size);
     return CryptoResult::Success(std::move(output));
 }
 
-CryptoResult PacketCrypto::Decrypt(const char* ciphertext, uint16_t size) {
+CryptoSpan PacketCrypto::DecryptInPlace(char* ciphertext, uint16_t size) {
     if (!initialized_ || !hKey_) {
-        return CryptoResult::Failure("Crypto not initialized");
+        return CryptoSpan::Failure("Crypto not initialized");
     }
 
     // 최소 크기 검증: SeqNum(4) + IV(16) + 최소 1블록(16)
     const uint16_t min_size = CryptoConstants::SEQUENCE_NUM_SIZE + CryptoConstants::IV_SIZE + CryptoConstants::AES_BLOCK_SIZE;
     if (size < min_size) {
-        return CryptoResult::Failure("Encrypted payload too small");
+        return CryptoSpan::Failure("Encrypted payload too small");
     }
 
     UTILITY::LockGuard lock(crypto_mutex_);
@@ -182,52 +188,33 @@ CryptoResult PacketCrypto::Decrypt(const char* ciphertext, uint16_t size) {
     std::memcpy(&received_seq, ciphertext, CryptoConstants::SEQUENCE_NUM_SIZE);
 
     if (!ValidateSequence(received_seq)) {
-        return CryptoResult::Failure("Sequence number validation failed (possible replay attack)");
+        return CryptoSpan::Failure("Sequence number validation failed (possible replay attack)");
     }
 
-    // 2. IV 추출
+    // 2. IV 추출 (BCryptDecrypt가 IV를 변경하므로 로컬 복사본 사용)
     unsigned char iv[CryptoConstants::IV_SIZE];
     std::memcpy(iv, ciphertext + CryptoConstants::SEQUENCE_NUM_SIZE, CryptoConstants::IV_SIZE);
 
-    // 3. 암호문 추출
-    const char* encrypted_data = ciphertext + CryptoConstants::SEQUENCE_NUM_SIZE + CryptoConstants::IV_SIZE;
-    uint16_t encrypted_size = size - CryptoConstants::SEQUENCE_NUM_SIZE - CryptoConstants::IV_SIZE;
+    // 3. 암호문 위치에 그대로 복호화 (평문 크기 <= 암호문 크기이므로 출력 크기 조회 생략)
+    char* encrypted_data = ciphertext + CryptoConstants::CRYPTO_HEADER_SIZE;
+    ULONG encrypted_size = size - CryptoConstants::CRYPTO_HEADER_SIZE;
 
-    // 4. 복호화 출력 크기 계산
-    ULONG plain_size = 0;
-    NTSTATUS status = BCryptDecrypt(
-        static_cast<BCRYPT_KEY_HANDLE>(hKey_),
-        (PUCHAR)encrypted_data, encrypted_size,
-        nullptr, iv, CryptoConstants::IV_SIZE,
-        nullptr, 0, &plain_size,
-        BCRYPT_BLOCK_PADDING);
-    if (!NT_SUCCESS(status)) {
-        return CryptoResult::Failure("BCryptDecrypt size calculation failed");
-    }
-
-    // 5. 복호화 실행
-    // IV를 다시 세팅 (BCryptDecrypt가 IV를 변경)
-    std::memcpy(iv, ciphertext + CryptoConstants::SEQUENCE_NUM_SIZE, CryptoConstants::IV_SIZE);
-
-    std::vector<char> output(plain_size);
     ULONG result_size = 0;
-    status = BCryptDecrypt(
+    NTSTATUS status = BCryptDecrypt(
         static_cast<BCRYPT_KEY_HANDLE>(hKey_),
         (PUCHAR)encrypted_data, encrypted_size,
         nullptr, iv, CryptoConstants::IV_SIZE,
-        (PUCHAR)output.data(), plain_size, &result_size,
+        (PUCHAR)encrypted_data, encrypted_size, &result_size,
         BCRYPT_BLOCK_PADDING);
 
     if (!NT_SUCCESS(status)) {
-        return CryptoResult::Failure("BCryptDecrypt failed");
+        return CryptoSpan::Failure("BCryptDecrypt failed");
     }
 
-    output.resize(result_size);
-
-    // 6. 시퀀스 번호 갱신
+    // 4. 시퀀스 번호 갱신
     recv_sequence_ = received_seq;
 
-    return CryptoResult::Success(std::move(output));
+    return CryptoSpan::Success(encrypted_data, static_cast<uint16_t>(result_size));
 }
 
 bool PacketCrypto::ValidateSequence(uint32_t received_seq) {
@@ -50,6 +50,15 @@ namespace CryptoConstants {
     // 암호화 오버헤드: SeqNum(4) + IV(16) + 패딩(최대 16)
     constexpr int MAX_CRYPTO_OVERHEAD = SEQUENCE_NUM_SIZE + IV_SIZE + AES_BLOCK_SIZE;
 
+    // 암호문 앞에 붙는 고정 헤더: SeqNum(4) + IV(16)
+    constexpr int CRYPTO_HEADER_SIZE = SEQUENCE_NUM_SIZE + IV_SIZE;
+
+    // 평문 크기 -> [SeqNum][IV][CipherText] 전체 크기
+    // PKCS7 패딩은 항상 1~16바이트를 추가하므로 다음 블록 경계로 올림
+    constexpr size_t GetEncryptedSize(size_t plain_size) {
+        return CRYPTO_HEADER_SIZE + (plain_size / AES_BLOCK_SIZE + 1) * AES_BLOCK_SIZE;
+    }
+
     // S2S 내부망 통신은 암호화를 건너뛰는 옵션
     constexpr bool ENCRYPT_S2S = false;
     constexpr bool ENCRYPT_CLIENT = true;
@@ -69,6 +78,17 @@ struct CryptoResult {
     }
 };
 
+// 제자리 복호화 결과 (입력 버퍼 내부를 가리키는 뷰, 소유권 없음)
+struct CryptoSpan {
+    bool success = false;
+    char* data = nullptr;
+    uint16_t size = 0;
+    const char* error_message = "";
+
+    static CryptoSpan Success(char* d, uint16_t s) { return { true, d, s, "" }; }
+    static CryptoSpan Failure(const char* msg) { return { false, nullptr, 0, msg }; }
+};
+
 class PacketCrypto {
 private:
     bool initialized_ = false;
@@ -106,11 +126,33 @@ public:
     // 반환: [SeqNum(4B)][IV(16B)][EncryptedData]
     CryptoResult Encrypt(const char* plaintext, uint16_t size);
 
+    // ==========================================
+    //   제로 카피 암호화 (호출 측 버퍼에 직접 기록)
+    //
+    // out에 [SeqNum(4B)][IV(16B)][EncryptedData]를 기록하고 기록한 바이트 수를 반환 (실패 시 0)
+    // out_capacity는 GetEncryptedSize(size) 이상이어야 함
+    //
+    // plaintext == out + CRYPTO_HEADER_SIZE 이면 제자리(in-place) 암호화
+    //   -> SerializeToArray로 풀 버퍼의 평문 위치에 직렬화한 뒤 그대로 암호화
+    //   -> 중간 std::string / std::vector 할당 및 복사 없음
+    // ==========================================
+    size_t EncryptInto(const char* plaintext, uint16_t size, char* out, size_t out_capacity);
+
     // 암호화된 데이터를 복호화
     // 입력: [SeqNum(4B)][IV(16B)][EncryptedData]
     // 시퀀스 번호 검증 포함
     CryptoResult Decrypt(const char* ciphertext, uint16_t size);
 
+    // ==========================================
+    //   제자리 복호화 (수신 버퍼에 평문을 덮어씀)
+    //
+    // 변경 전: Decrypt()가 패킷마다 std::vector<char>를 새로 할당해 평문을 반환
+    // 변경 후: 암호문 영역에 평문을 그대로 기록하고 그 위치를 CryptoSpan으로 반환
+    //   -> 반환된 data는 ciphertext + CRYPTO_HEADER_SIZE를 가리킴
+    //   -> ciphertext 버퍼가 유효한 동안에만 사용 가능 (Dispatch 후 ConsumeFrame)
+    // ==========================================
+    CryptoSpan DecryptInPlace(char* ciphertext, uint16_t size);
+
     // 시퀀스 번호만 검증 (복호화 없이)
     bool ValidateSequence(uint32_t received_seq);
 
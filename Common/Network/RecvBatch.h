@@ -0,0 +1,131 @@
+﻿#pragma once
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <boost/lockfree/queue.hpp>
+
+#include "../Define/GameConstants.h"
+
+// ==========================================
+//   수신 배치 (RecvBatch) - I/O 스레드 -> game_strand_ 일괄 전달
+//
+// [변경 전 문제]
+//   GatewaySession::ProcessFrames가 S2S 프레임마다
+//   -> make_shared<std::vector<char>>로 페이로드 복사 (힙 할당 2회: 제어 블록 + 데이터)
+//   -> game_strand_에 프레임마다 별도 람다를 post (핸들러 할당 + strand 스케줄링 1회씩)
+//   -> Gateway가 초당 수천 건의 이동을 중계하면 할당/스케줄링 비용이 패킷 수에 비례
+//
+// [변경 후]
+//   async_read_some 1회에서 꺼낸 프레임을 풀에서 대여한 RecvBatch 하나에 연속으로 복사
+//   -> 배치 1개를 game_strand_에 한 번만 post, strand 안에서 ForEach로 순회하며 Dispatch
+//   -> RecvBatch는 shared_ptr 커스텀 딜리터로 사용 후 풀에 반납 (버퍼 용량 재사용)
+//   -> 한 번의 읽기로 얻는 프레임 총량은 수신 링 버퍼 크기를 넘지 않으므로
+//      배치 용량을 S2S_RECV_RING_SIZE로 잡으면 재할당이 발생하지 않음
+//   -> decoded 프레임: I/O 스레드가 미리 디코딩한 명령 구조체 바이트
+//      (PacketDispatcher 타입 명령 모드, strand에서는 InvokeCommand로 바로 실행)
+//
+// [사용 예]
+//   auto batch = RecvBatchPool::GetInstance().Acquire();
+//   while (stream_.PeekFrame(frame) == FrameResult::COMPLETE) {
+//       batch->Append(frame.id, frame.payload, frame.payload_size);
+//       stream_.ConsumeFrame(frame);
+//   }
+//   post(game_strand_, [self, batch]() {
+//       batch->ForEach([&](uint16_t id, char* data, uint16_t size, bool decoded) { Dispatch(...); });
+//   });
+// ==========================================
+class RecvBatch {
+public:
+    struct FrameRef {
+        uint16_t id;
+        uint16_t size;
+        uint32_t offset;
+        bool decoded;
+    };
+
+private:
+    std::vector<char> storage_;
+    std::vector<FrameRef> frames_;
+    size_t used_ = 0;
+
+public:
+    explicit RecvBatch(size_t capacity) {
+        storage_.resize(capacity);
+        frames_.reserve(GameConstants::Network::RECV_BATCH_FRAME_RESERVE);
+    }
+
+    RecvBatch(const RecvBatch&) = delete;
+    RecvBatch& operator=(const RecvBatch&) = delete;
+
+    // 페이로드를 배치 저장소 뒤에 복사. 용량 부족 시 false (호출 측에서 배치를 끊고 새로 대여)
+    //   decoded: payload가 원본 패킷이 아니라 디코딩된 명령 구조체 바이트인 경우 true
+    bool Append(uint16_t id, const char* payload, uint16_t size, bool decoded = false) {
+        if (used_ + size > storage_.size()) return false;
+
+        if (size > 0) {
+            std::memcpy(storage_.data() + used_, payload, size);
+        }
+        frames_.push_back({ id, size, static_cast<uint32_t>(used_), decoded });
+        used_ += size;
+        return true;
+    }
+
+    bool Empty() const { return frames_.empty(); }
+    size_t FrameCount() const { return frames_.size(); }
+
+    // func(uint16_t id, char* payload, uint16_t size, bool decoded) - 빈 페이로드는 nullptr로 전달
+    template <typename Func>
+    void ForEach(Func&& func) {
+        for (const auto& f : frames_) {
+            func(f.id, f.size > 0 ? storage_.data() + f.offset : nullptr, f.size, f.decoded);
+        }
+    }
+
+    void Reset() {
+        frames_.clear();
+        used_ = 0;
+    }
+};
+
+// ==========================================
+//   RecvBatch 오브젝트 풀
+//
+// 배치는 "읽기 1회 ~ game_strand_ 처리 완료" 동안만 살아있으므로
+// 동시에 필요한 개수는 strand 적체량 정도로 작음 -> 필요할 때 생성하고 반납분을 재사용
+// ==========================================
+class RecvBatchPool {
+private:
+    boost::lockfree::queue<RecvBatch*> pool_{ 64 };
+
+    RecvBatchPool() = default;
+
+public:
+    ~RecvBatchPool() {
+        RecvBatch* batch = nullptr;
+        while (pool_.pop(batch)) delete batch;
+    }
+
+    static RecvBatchPool& GetInstance() {
+        static RecvBatchPool instance;
+        return instance;
+    }
+
+    std::shared_ptr<RecvBatch> Acquire() {
+        RecvBatch* batch = nullptr;
+        if (!pool_.pop(batch)) {
+            batch = new RecvBatch(GameConstants::Network::S2S_RECV_RING_SIZE);
+        }
+        return std::shared_ptr<RecvBatch>(batch, [](RecvBatch* b) {
+            RecvBatchPool::GetInstance().Release(b);
+        });
+    }
+
+    void Release(RecvBatch* batch) {
+        batch->Reset();
+        if (!pool_.push(batch)) {
+            delete batch;
+        }
+    }
+};
@@ -0,0 +1,183 @@
+﻿#pragma once
+#include <memory>
+#include <cstdint>
+#include <cstring>
+
+#include "../MemoryPool.h"
+
+// ==========================================
+//   S2S 번들 프레임 (Gateway <-> GameServer)
+//
+// [변경 전 문제]
+//   S2S 메시지 1개 = PacketHeader 프레임 1개
+//   -> Gateway는 유저마다 MoveReq를, GameServer는 이동마다 MoveRes를 개별 프레임으로 전송
+//   -> 수천 명이 움직이면 프레임 수만큼 큐 엔트리/풀 버퍼/수신 측 프레임 파싱이 발생
+//
+// [변경 후]
+//   같은 strand 턴에 쌓인 메시지를 번들 프레임 1개로 묶어서 전송
+//   -> [PacketHeader{size, PKT_S2S_BUNDLE}]
+//      [sub id:uint16][sub len:varint][sub payload] × N
+//   -> 서브 헤더는 3~4바이트 (len <= 127이면 3바이트)
+//   -> 수신 측은 번들 1개를 한 번 훑으며 서브 메시지를 순서대로 꺼냄
+//
+// [플러시 시점] (송신 측 strand 안에서)
+//   1. 누적 크기가 S2S_BUNDLE_FLUSH_BYTES 이상이거나 다음 메시지가 들어갈 자리가 없을 때
+//   2. 첫 메시지가 들어올 때 strand에 예약한 플러시 작업이 실행될 때
+//      -> 그 사이 strand에 쌓인 Send가 모두 같은 번들로 합쳐짐 (타이머 불필요)
+//      -> 부하가 낮아 메시지가 1개뿐이면 번들을 만들지 않고 원래 프레임을 그대로 전송
+//
+// [스레드 안전성]
+//   내부에 락이 없습니다. 반드시 소유 세션의 strand_ 안에서만 접근해야 합니다.
+// ==========================================
+class S2SBundleWriter {
+public:
+    static constexpr size_t HEADER_SIZE = sizeof(uint16_t) * 2;
+    static constexpr size_t MAX_SUB_HEADER_SIZE = sizeof(uint16_t) + 3;   // id + varint(uint16)
+    static constexpr size_t CAPACITY = MAX_PACKET_SIZE;
+
+    struct Flushed {
+        std::shared_ptr<SendBuffer> buffer;
+        uint16_t size = 0;
+        uint32_t count = 0;     // 포함된 메시지 수 (1이면 원래 프레임)
+    };
+
+private:
+    uint16_t bundle_id_;
+
+    // 첫 메시지는 복사하지 않고 원래 프레임을 보관 -> 혼자 플러시되면 그대로 전송
+    std::shared_ptr<SendBuffer> first_frame_;
+    uint16_t first_size_ = 0;
+
+    std::shared_ptr<SendBuffer> bundle_;
+    size_t used_ = HEADER_SIZE;
+    uint32_t count_ = 0;
+
+    static size_t VarintSize(uint16_t value) {
+        return value < 0x80 ? 1 : (value < 0x4000 ? 2 : 3);
+    }
+
+    void AppendSub(const char* frame, uint16_t frame_size) {
+        uint16_t id;
+        std::memcpy(&id, frame + sizeof(uint16_t), sizeof(uint16_t));
+        uint16_t len = static_cast<uint16_t>(frame_size - HEADER_SIZE);
+
+        char* dst = bundle_->Data() + used_;
+        std::memcpy(dst, &id, sizeof(uint16_t));
+        dst += sizeof(uint16_t);
+
+        uint32_t v = len;
+        while (v >= 0x80) {
+            *dst++ = static_cast<char>((v & 0x7F) | 0x80);
+            v >>= 7;
+        }
+        *dst++ = static_cast<char>(v);
+
+        if (len > 0) std::memcpy(dst, frame + HEADER_SIZE, len);
+        used_ += sizeof(uint16_t) + VarintSize(len) + len;
+    }
+
+public:
+    explicit S2SBundleWriter(uint16_t bundle_id) : bundle_id_(bundle_id) {}
+
+    S2SBundleWriter(const S2SBundleWriter&) = delete;
+    S2SBundleWriter& operator=(const S2SBundleWriter&) = delete;
+
+    bool Empty() const { return count_ == 0; }
+    uint32_t Count() const { return count_; }
+
+    // 번들로 만들었을 때의 누적 크기 (첫 메시지만 있을 때도 번들 기준으로 계산)
+    size_t Bytes() const {
+        if (count_ == 1) {
+            uint16_t len = static_cast<uint16_t>(first_size_ - HEADER_SIZE);
+            return HEADER_SIZE + sizeof(uint16_t) + VarintSize(len) + len;
+        }
+        return used_;
+    }
+
+    // [PacketHeader][Payload] 프레임이 현재 번들에 더 들어갈 수 있는지
+    bool Fits(uint16_t frame_size) const {
+        size_t len = frame_size - HEADER_SIZE;
+        return Bytes() + sizeof(uint16_t) + VarintSize(static_cast<uint16_t>(len)) + len <= CAPACITY;
+    }
+
+    // 호출 전 Fits()로 확인할 것. frame은 전송 완료 전까지 수정하지 않는 [PacketHeader][Payload]
+    void Append(const std::shared_ptr<SendBuffer>& frame, uint16_t frame_size) {
+        if (count_ == 0) {
+            first_frame_ = frame;
+            first_size_ = frame_size;
+            count_ = 1;
+            return;
+        }
+
+        if (count_ == 1) {
+            // 두 번째 메시지부터 번들 버퍼를 대여하고 첫 메시지를 옮겨 담음
+            bundle_ = std::shared_ptr<SendBuffer>(SendBufferPool::GetInstance().Acquire(CAPACITY), SendBufferDeleter());
+            used_ = HEADER_SIZE;
+            AppendSub(first_frame_->Data(), first_size_);
+            first_frame_.reset();
+        }
+
+        AppendSub(frame->Data(), frame_size);
+        ++count_;
+    }
+
+    // 현재 번들을 꺼내고 비움 (메시지가 1개면 원래 프레임 반환)
+    Flushed Take() {
+        Flushed out;
+        out.count = count_;
+
+        if (count_ == 1) {
+            out.buffer = std::move(first_frame_);
+            out.size = first_size_;
+        }
+        else if (count_ > 1) {
+            uint16_t total = static_cast<uint16_t>(used_);
+            std::memcpy(bundle_->Data(), &total, sizeof(uint16_t));
+            std::memcpy(bundle_->Data() + sizeof(uint16_t), &bundle_id_, sizeof(uint16_t));
+            out.buffer = std::move(bundle_);
+            out.size = total;
+        }
+
+        first_frame_.reset();
+        bundle_.reset();
+        first_size_ = 0;
+        used_ = HEADER_SIZE;
+        count_ = 0;
+        return out;
+    }
+
+    void Clear() { Take(); }
+};
+
+// ==========================================
+//   번들 페이로드 순회 (수신 측)
+//
+// func(uint16_t id, char* payload, uint16_t size) - 빈 페이로드는 nullptr로 전달
+// 반환값: false면 서브 헤더가 잘렸거나 길이가 범위를 벗어남 (그 앞까지는 이미 전달됨)
+// ==========================================
+template <typename Func>
+inline bool ForEachBundled(char* payload, uint16_t payload_size, Func&& func) {
+    size_t pos = 0;
+    while (pos < payload_size) {
+        if (payload_size - pos < sizeof(uint16_t) + 1) return false;
+
+        uint16_t id;
+        std::memcpy(&id, payload + pos, sizeof(uint16_t));
+        pos += sizeof(uint16_t);
+
+        uint32_t len = 0;
+        int shift = 0;
+        while (true) {
+            if (pos >= payload_size || shift > 14) return false;
+            uint8_t byte = static_cast<uint8_t>(payload[pos++]);
+            len |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) break;
+            shift += 7;
+        }
+
+        if (len > payload_size - pos) return false;
+        func(id, len > 0 ? payload + pos : nullptr, static_cast<uint16_t>(len));
+        pos += len;
+    }
+    return true;
+}
@@ -0,0 +1,127 @@
+﻿#pragma once
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#include "../MemoryPool.h"
+#include "../Define/Define_Server.h"
+
+#ifdef  DEF_USE_LZ4_COMPRESSION
+#include <lz4.h>
+#endif
+
+// ==========================================
+//   S2S 번들 압축 (LZ4, 링크별 협상)
+//
+// [변경 전 문제]
+//   GameGatewayMoveRes 등 S2S 번들에는 반복되는 account_id 문자열과
+//   비슷한 좌표값이 그대로 실려 Gateway <-> GameServer 대역폭을 차지
+//   -> 같은 호스트에서는 문제가 없지만 호스트를 분리하면 링크 대역폭이 병목
+//
+// [변경 후]
+//   DEF_USE_LZ4_COMPRESSION 빌드에서 S2S_COMPRESS_MIN_BYTES 이상인 번들만 LZ4 블록 압축
+//   -> 프레임: [PacketHeader{size, PKT_S2S_BUNDLE_LZ4}][raw_size:uint16][LZ4 block]
+//   -> 압축 결과가 원본보다 작지 않으면 원본 번들을 그대로 전송
+//   -> 수신 측은 복원한 번들 페이로드를 기존 ForEachBundled로 순회
+//
+// [협상]
+//   Gateway 레인이 GatewayGameLaneHello.compression_flags로 지원 코덱을 알리고,
+//   GameServer가 양쪽 모두 지원하는 코덱을 GameGatewayLaneHelloAck로 돌려줌
+//   -> 각 송신 측은 협상이 끝난 링크에서만 압축 (재연결 시 다시 협상)
+//   -> 어느 한쪽이라도 플래그 없이 빌드되면 압축 없이 동작
+// ==========================================
+namespace S2SCompression {
+
+    constexpr uint32_t FLAG_LZ4 = 1u << 0;
+    constexpr size_t RAW_SIZE_FIELD = sizeof(uint16_t);
+    constexpr size_t HEADER_SIZE = sizeof(uint16_t) * 2;
+
+    // 이 빌드가 지원하는 코덱 (LaneHello / LaneHelloAck에 실어 보냄)
+    inline uint32_t SupportedFlags() {
+#ifdef  DEF_USE_LZ4_COMPRESSION
+        return FLAG_LZ4;
+#else
+        return 0;
+#endif
+    }
+
+    // ==========================================
+    //   압축률 통계 (프로세스 전역, 모니터링용)
+    // ==========================================
+    class Stats {
+    private:
+        inline static std::atomic<uint64_t> raw_bytes_{ 0 };
+        inline static std::atomic<uint64_t> wire_bytes_{ 0 };
+        inline static std::atomic<uint64_t> compressed_frames_{ 0 };
+        inline static std::atomic<uint64_t> skipped_frames_{ 0 };   // 압축해도 줄지 않아 원본 전송
+
+    public:
+        static void RecordCompressed(size_t raw, size_t wire) {
+            raw_bytes_.fetch_add(raw, std::memory_order_relaxed);
+            wire_bytes_.fetch_add(wire, std::memory_order_relaxed);
+            compressed_frames_.fetch_add(1, std::memory_order_relaxed);
+        }
+        static void RecordSkipped() { skipped_frames_.fetch_add(1, std::memory_order_relaxed); }
+
+        static uint64_t GetCompressedFrames() { return compressed_frames_.load(std::memory_order_relaxed); }
+        static uint64_t GetSkippedFrames() { return skipped_frames_.load(std::memory_order_relaxed); }
+
+        // 압축 프레임 기준 전송 바이트 / 원본 바이트 (낮을수록 좋음, 0이면 압축 이력 없음)
+        static double GetRatio() {
+            uint64_t raw = raw_bytes_.load(std::memory_order_relaxed);
+            if (raw == 0) return 0.0;
+            return static_cast<double>(wire_bytes_.load(std::memory_order_relaxed)) / static_cast<double>(raw);
+        }
+    };
+
+    // [PacketHeader][bundle payload] 프레임을 압축 프레임으로 변환
+    // 압축이 불가능하거나 이득이 없으면 nullptr 반환 (호출 측은 원본 전송)
+    inline std::shared_ptr<SendBuffer> CompressFrame(const char* frame, uint16_t frame_size,
+        uint16_t compressed_id, uint16_t& out_size) {
+#ifdef  DEF_USE_LZ4_COMPRESSION
+        uint16_t raw_size = static_cast<uint16_t>(frame_size - HEADER_SIZE);
+        size_t prefix = HEADER_SIZE + RAW_SIZE_FIELD;
+        if (prefix >= frame_size) return nullptr;
+
+        // 원본보다 작은 결과만 의미가 있으므로 출력 상한을 원본 크기로 제한
+        int cap = static_cast<int>(frame_size - prefix);
+        auto out = std::shared_ptr<SendBuffer>(SendBufferPool::GetInstance().Acquire(frame_size), SendBufferDeleter());
+        int written = LZ4_compress_default(frame + HEADER_SIZE, out->Data() + prefix, raw_size, cap);
+        if (written <= 0) {
+            Stats::RecordSkipped();
+            return nullptr;
+        }
+
+        out_size = static_cast<uint16_t>(prefix + written);
+        std::memcpy(out->Data(), &out_size, sizeof(uint16_t));
+        std::memcpy(out->Data() + sizeof(uint16_t), &compressed_id, sizeof(uint16_t));
+        std::memcpy(out->Data() + HEADER_SIZE, &raw_size, sizeof(uint16_t));
+        Stats::RecordCompressed(frame_size, out_size);
+        return out;
+#else
+        (void)frame; (void)frame_size; (void)compressed_id; (void)out_size;
+        return nullptr;
+#endif
+    }
+
+    // 압축 프레임 페이로드([raw_size][LZ4 block])를 out에 복원
+    // 반환값: 복원된 번들 페이로드 크기, 실패 시 -1
+    inline int DecompressPayload(const char* payload, uint16_t payload_size, char* out, size_t out_capacity) {
+#ifdef  DEF_USE_LZ4_COMPRESSION
+        if (payload_size < RAW_SIZE_FIELD) return -1;
+
+        uint16_t raw_size;
+        std::memcpy(&raw_size, payload, sizeof(uint16_t));
+        if (raw_size > out_capacity) return -1;
+
+        int restored = LZ4_decompress_safe(payload + RAW_SIZE_FIELD, out,
+            static_cast<int>(payload_size - RAW_SIZE_FIELD), static_cast<int>(raw_size));
+        return (restored == static_cast<int>(raw_size)) ? restored : -1;
+#else
+        (void)payload; (void)payload_size; (void)out; (void)out_capacity;
+        return -1;
+#endif
+    }
+
+} // namespace S2SCompression
@@ -0,0 +1,364 @@
+﻿#pragma once
+#include <array>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_map>
+#include <boost/asio/buffer.hpp>
+
+#include "../MemoryPool.h"
+#include "../Define/GameConstants.h"
+
+// ==========================================
+// Gather Write 통계 (프로세스 전역)
+//
+// "syscall 1회당 몇 개의 패킷을 내보냈는가"를 측정하기 위한 카운터
+//   -> GetPacketsPerWrite()가 1.0에 가까우면 배치 효과가 없는 상태
+//   -> AOI 브로드캐스트가 몰리는 구간에서 값이 커져야 정상
+// ==========================================
+class GatherWriteStats {
+private:
+    inline static std::atomic<uint64_t> write_calls_{ 0 };
+    inline static std::atomic<uint64_t> packets_{ 0 };
+    inline static std::atomic<uint64_t> bytes_{ 0 };
+
+public:
+    static void Record(size_t packet_count, size_t byte_count) {
+        write_calls_.fetch_add(1, std::memory_order_relaxed);
+        packets_.fetch_add(packet_count, std::memory_order_relaxed);
+        bytes_.fetch_add(byte_count, std::memory_order_relaxed);
+    }
+
+    static uint64_t GetWriteCalls() { return write_calls_.load(std::memory_order_relaxed); }
+    static uint64_t GetPackets() { return packets_.load(std::memory_order_relaxed); }
+    static uint64_t GetBytes() { return bytes_.load(std::memory_order_relaxed); }
+
+    static double GetPacketsPerWrite() {
+        uint64_t calls = GetWriteCalls();
+        if (calls == 0) return 0.0;
+        return static_cast<double>(GetPackets()) / static_cast<double>(calls);
+    }
+};
+
+// ==========================================
+//   세션 송신 우선순위 레인
+//
+// 변경 전: 세션당 FIFO 1개 -> 군중 이벤트로 이동 패킷 수백 개가 쌓이면
+//   접속 응답/전투 결과도 그 뒤에서 대기
+//
+// 변경 후: 클래스마다 별도 레인(deque)을 두고 PrepareBatch()가 높은 레인부터 채움
+//   -> CONTROL > COMBAT > CHAT > MOVEMENT 순서 (엄격 우선순위)
+//   -> 같은 레인 안에서는 적재 순서 유지
+//   -> 이동은 최하위 레인에서 대체(coalesce)/드랍되므로 상위 레인 폭주 시에도
+//      기아 상태의 비용은 "최신 위치가 늦게 도착"으로 한정됨
+//
+// 레인 간 순서가 바뀌므로 암호화 세션의 시퀀스 번호는 적재 시점이 아니라
+// 전송 배치에 실리는 시점에 발급해야 함 -> 봉인(seal) 지연 엔트리 참고
+// ==========================================
+enum class SendClass : uint8_t {
+    CONTROL = 0,    // 접속/인증/협상 응답 (최우선, 드랍 불가)
+    COMBAT,         // 전투 결과 (드랍 불가)
+    CHAT,           // 채팅/신뢰성 상태 갱신 (드랍 불가)
+    MOVEMENT,       // 같은 엔티티의 최신 값만 유효 (최하위, 대체/드랍 가능)
+    COUNT,
+};
+
+enum class PushResult : uint8_t {
+    QUEUED,         // 정상 적재
+    COALESCED,      // 이전 이동 패킷을 대체하며 적재
+    DROPPED,        // soft 예산 초과로 드랍 (MOVEMENT)
+    OVER_BUDGET,    // hard 예산 초과 (MOVEMENT 외) -> 연결 종료 대상
+};
+
+// 큐에 실제로 적재되었는지 (DROPPED/OVER_BUDGET이면 큐는 그대로)
+//   -> 세션은 "적재 전 큐가 비어 있었고 + 이번에 적재됨"일 때만 DoWrite를 시작
+inline bool IsQueued(PushResult result) {
+    return result == PushResult::QUEUED || result == PushResult::COALESCED;
+}
+
+// 세션별 송신 큐 지표
+struct SendQueueStats {
+    size_t queued_bytes = 0;        // 현재 대기 바이트 (전송 중 포함)
+    size_t peak_bytes = 0;          // 최대 대기 바이트
+    uint64_t coalesced = 0;         // 최신 값으로 대체된 이동 패킷 수
+    uint64_t dropped = 0;           // soft 예산 초과로 드랍된 패킷 수
+    uint64_t seal_failed = 0;       // 전송 직전 봉인(암호화) 실패로 버려진 패킷 수
+};
+
+// ==========================================
+// SendQueue - Scatter/Gather 배치 전송 큐 (gather write 근거는 PrepareBatch 참고)
+//
+// [스레드 안전성]
+//   내부에 락이 없습니다. 반드시 소유 세션의 strand_ 안에서만 접근해야 합니다.
+// ==========================================
+class SendQueue {
+public:
+    static constexpr size_t LANE_COUNT = static_cast<size_t>(SendClass::COUNT);
+
+    struct Entry {
+        std::shared_ptr<SendBuffer> buffer;     // nullptr이면 무효화(tombstone)된 엔트리
+        size_t size;                            // 전송될 최종 크기 (봉인 후 크기)
+        uint64_t coalesce_key = 0;              // 0이면 대체 대상 아님
+
+        // true면 buffer는 평문 프레임 [PacketHeader][Payload] (공유 버퍼일 수 있음)
+        //   -> PrepareBatch()에 실리는 순간 sealer가 세션 전용 버퍼로 암호화해 교체
+        bool needs_seal = false;
+    };
+
+    // async_write에 넘기는 버퍼 시퀀스 뷰
+    //   -> asio는 버퍼 시퀀스를 값으로 복사하므로 vector를 그대로 넘기면 매 전송마다 힙 할당이 발생
+    //   -> 포인터 2개짜리 뷰만 복사되도록 함 (실제 배열은 gather_가 보관)
+    struct GatherView {
+        using value_type = boost::asio::const_buffer;
+        using const_iterator = const boost::asio::const_buffer*;
+
+        const_iterator first;
+        const_iterator last;
+
+        const_iterator begin() const { return first; }
+        const_iterator end() const { return last; }
+        bool empty() const { return first == last; }
+    };
+
+private:
+    struct Lane {
+        std::deque<Entry> queue;
+        uint64_t front_seq = 0;     // queue.front()의 일련번호
+        size_t inflight = 0;        // 현재 async_write에 실려있는 앞쪽 엔트리 수 (무효화 엔트리 포함)
+    };
+
+    std::array<Lane, LANE_COUNT> lanes_;
+    size_t total_entries_ = 0;
+    std::vector<boost::asio::const_buffer> gather_;
+
+    // 현재 async_write에 실려있는 바이트 수
+    size_t inflight_bytes_ = 0;
+
+    // 대체용 인덱스: coalesce_key -> MOVEMENT 레인 엔트리 일련번호
+    //   일련번호 - front_seq = 현재 deque 인덱스 (앞에서만 제거되므로 성립)
+    std::unordered_map<uint64_t, uint64_t> coalesce_index_;
+
+    // 바이트 예산 (0 = 무제한, S2S 세션 기본값)
+    size_t soft_budget_ = 0;
+    size_t hard_budget_ = 0;
+
+    SendQueueStats stats_;
+
+    Lane& MovementLane() { return lanes_[static_cast<size_t>(SendClass::MOVEMENT)]; }
+
+    void AddBytes(size_t size) {
+        stats_.queued_bytes += size;
+        if (stats_.queued_bytes > stats_.peak_bytes) stats_.peak_bytes = stats_.queued_bytes;
+    }
+
+    // 제거되는 엔트리의 대체 인덱스 정리 (더 최신 엔트리를 가리키면 유지)
+    void ForgetEntry(const Entry& entry, uint64_t seq) {
+        if (entry.buffer) stats_.queued_bytes -= entry.size;
+        if (entry.coalesce_key == 0) return;
+
+        auto it = coalesce_index_.find(entry.coalesce_key);
+        if (it != coalesce_index_.end() && it->second == seq) {
+            coalesce_index_.erase(it);
+        }
+    }
+
+    // 전송 중이 아닌, 같은 엔티티의 대기 중 이동 엔트리
+    Entry* FindPendingMovement(uint64_t coalesce_key) {
+        if (coalesce_key == 0) return nullptr;
+
+        Lane& lane = MovementLane();
+        auto it = coalesce_index_.find(coalesce_key);
+        if (it == coalesce_index_.end() || it->second < lane.front_seq) return nullptr;
+
+        size_t index = static_cast<size_t>(it->second - lane.front_seq);
+        if (index < lane.inflight || index >= lane.queue.size() || !lane.queue[index].buffer) return nullptr;
+        return &lane.queue[index];
+    }
+
+public:
+    SendQueue() {
+        gather_.reserve(GameConstants::Network::MAX_GATHER_BUFFERS);
+    }
+
+    bool Empty() const { return total_entries_ == 0; }
+    size_t Size() const { return total_entries_; }
+    bool IsWriting() const {
+        for (const Lane& lane : lanes_) {
+            if (lane.inflight > 0) return true;
+        }
+        return false;
+    }
+
+    void SetByteBudget(size_t soft_bytes, size_t hard_bytes) {
+        soft_budget_ = soft_bytes;
+        hard_budget_ = hard_bytes;
+    }
+
+    const SendQueueStats& GetStats() const { return stats_; }
+    size_t GetQueuedBytes() const { return stats_.queued_bytes; }
+
+    // ==========================================
+    //   메시지 클래스별 송신 정책 + 바이트 예산
+    //
+    // 변경 전: 세션당 SEND_QUEUE_MAX_SIZE(100,000개) 개수 상한만 존재
+    //   -> 느린 클라이언트 1명이 4KB 버퍼 기준 최대 약 400MB를 점유 가능
+    //   -> 상한 초과 시 어떤 패킷이 버려질지 임의적 (전투/채팅도 유실)
+    //
+    // 변경 후: 바이트 단위 예산 + 메시지 클래스별 정책
+    //   -> MOVEMENT: 같은 엔티티(coalesce_key)의 이전 이동 패킷이 아직 대기 중이면
+    //                이전 것을 무효화(tombstone)하고 최신 것만 뒤에 추가 (최신 위치 우선)
+    //                soft 예산 초과 시 새 이동 패킷은 드랍 (다음 이동에서 복구됨)
+    //   -> 그 외:    제어/전투/채팅 패킷은 드랍하지 않고 보존
+    //                hard 예산 초과 시 OVER_BUDGET 반환 -> 세션이 연결 종료 판단
+    //
+    // 무효화된 엔트리를 제자리 교체하지 않고 뒤에 추가하는 이유:
+    //   같은 레인 안에서는 적재 순서대로 전송되어야 하므로 (수신 측 적용 순서 보장)
+    //   (무효화된 엔트리의 버퍼는 즉시 풀로 반납, 자리는 완료 시 함께 제거)
+    // ==========================================
+    // coalesce_key는 MOVEMENT에서는 대체 키, 그 외 클래스에서는 "같은 엔티티의 대기 중 이동을 무효화"
+    //   -> 신뢰성 상태(예: 이동 키프레임)가 상위 레인으로 먼저 나가면, 그 이전 기준의
+    //      이동 델타가 뒤늦게 도착해 새 기준에 잘못 적용되는 것을 막음
+    PushResult Push(std::shared_ptr<SendBuffer> buffer, size_t size,
+                    SendClass send_class = SendClass::CONTROL, uint64_t coalesce_key = 0,
+                    bool needs_seal = false) {
+        PushResult result = PushResult::QUEUED;
+        Entry* stale = FindPendingMovement(coalesce_key);
+
+        if (send_class == SendClass::MOVEMENT) {
+            size_t projected = stats_.queued_bytes + size - (stale ? stale->size : 0);
+            if (soft_budget_ != 0 && projected > soft_budget_) {
+                ++stats_.dropped;
+                return PushResult::DROPPED;
+            }
+        }
+        else if (hard_budget_ != 0 && stats_.queued_bytes + size > hard_budget_) {
+            return PushResult::OVER_BUDGET;
+        }
+
+        if (stale) {
+            stats_.queued_bytes -= stale->size;
+            stale->buffer.reset();  // 버퍼 즉시 반납, 자리는 tombstone으로 남김
+            ++stats_.coalesced;
+            result = PushResult::COALESCED;
+        }
+
+        Lane& lane = lanes_[static_cast<size_t>(send_class)];
+        if (send_class != SendClass::MOVEMENT) coalesce_key = 0;
+
+        lane.queue.push_back({ std::move(buffer), size, coalesce_key, needs_seal });
+        ++total_entries_;
+        if (coalesce_key != 0) {
+            coalesce_index_[coalesce_key] = lane.front_seq + lane.queue.size() - 1;
+        }
+        AddBytes(size);
+        return result;
+    }
+
+    // ==========================================
+    //   gather write - 세션 DoWrite()의 배치 전송
+    //
+    // 변경 전: 모든 세션의 DoWrite()가 send_queue_.front() 1개만 async_write
+    //   -> AOI 브로드캐스트로 한 세션에 패킷 20개가 쌓이면
+    //      syscall 20회 + 완료 핸들러 20회가 순차적으로 발생
+    //
+    // 변경 후: async_write(socket_, PrepareBatch(...)) 1회로 큐에 쌓인 패킷을
+    //          const_buffer 배열(WSABUF/iovec)로 묶어 전송
+    //   -> 1회 묶음 크기는 MAX_GATHER_BUFFERS(개수) / MAX_GATHER_BYTES(바이트)로 제한
+    //   -> 전송 중(in-flight)인 패킷은 완료 콜백까지 큐에 남아있으므로 버퍼 수명이 보장됨
+    //   -> 완료 시 FinishBatch()로 전송한 개수만큼 한 번에 제거, 남은 패킷이 있으면 이어서 전송
+    // ==========================================
+    // 높은 레인부터 상한까지 묶어서 gather 버퍼 배열을 구성
+    //   -> 첫 패킷은 바이트 상한과 무관하게 항상 포함 (진행 보장)
+    //   -> 무효화된 엔트리는 건너뛰되 완료 시 함께 제거되도록 개수에 포함
+    //   -> 봉인 지연 엔트리는 상한 검사를 통과해 배치에 실리는 순간 seal(entry) 호출
+    //      (실린 순서 = 시퀀스 발급 순서 = 전송 순서)
+    //      seal이 false를 반환하면 해당 엔트리는 무효화
+    //   -> 반환 뷰가 비어 있으면 큐 전체가 무효화 엔트리뿐이었다는 뜻
+    //      (살아있는 버퍼가 하나도 없으면 상한에 걸리지 않으므로 모든 엔트리가 실림)
+    //      세션은 빈 버퍼로 async_write를 시작하지 말고 FinishBatch(true)로 즉시 정리
+    template<typename Sealer>
+    GatherView PrepareBatch(Sealer&& seal) {
+        gather_.clear();
+        inflight_bytes_ = 0;
+        for (Lane& lane : lanes_) lane.inflight = 0;
+
+        const size_t max_buffers = static_cast<size_t>(GameConstants::Network::MAX_GATHER_BUFFERS);
+        const size_t max_bytes = static_cast<size_t>(GameConstants::Network::MAX_GATHER_BYTES);
+
+        bool full = false;
+        for (Lane& lane : lanes_) {
+            for (auto& entry : lane.queue) {
+                if (!entry.buffer) {
+                    ++lane.inflight;
+                    continue;
+                }
+                if (gather_.size() >= max_buffers ||
+                    (!gather_.empty() && inflight_bytes_ + entry.size > max_bytes)) {
+                    full = true;
+                    break;
+                }
+
+                ++lane.inflight;
+                if (entry.needs_seal) {
+                    size_t planned = entry.size;
+                    entry.needs_seal = false;
+                    if (!seal(entry)) {
+                        stats_.queued_bytes -= planned;
+                        entry.buffer.reset();
+                        ++stats_.seal_failed;
+                        continue;
+                    }
+                    stats_.queued_bytes = stats_.queued_bytes - planned + entry.size;
+                }
+
+                gather_.emplace_back(entry.buffer->Data(), entry.size);
+                inflight_bytes_ += entry.size;
+            }
+            if (full) break;
+        }
+        return GatherView{ gather_.data(), gather_.data() + gather_.size() };
+    }
+
+    // 봉인 지연 엔트리를 쓰지 않는 세션용
+    GatherView PrepareBatch() {
+        return PrepareBatch([](Entry&) { return true; });
+    }
+
+    // async_write 완료 시 호출: 전송한 패킷을 큐에서 제거 (버퍼는 풀로 반납됨)
+    void FinishBatch(bool success) {
+        if (success && !gather_.empty()) {
+            GatherWriteStats::Record(gather_.size(), inflight_bytes_);
+        }
+
+        for (Lane& lane : lanes_) {
+            size_t done = (std::min)(lane.inflight, lane.queue.size());
+            for (size_t i = 0; i < done; ++i) {
+                ForgetEntry(lane.queue[i], lane.front_seq + i);
+            }
+            lane.queue.erase(lane.queue.begin(), lane.queue.begin() + static_cast<std::ptrdiff_t>(done));
+            lane.front_seq += done;
+            lane.inflight = 0;
+            total_entries_ -= done;
+        }
+
+        gather_.clear();
+        inflight_bytes_ = 0;
+    }
+
+    // 대기 중인 패킷 폐기
+    //   -> 전송 중인 배치는 커널이 아직 버퍼를 참조할 수 있으므로 남겨두고,
+    //      완료 콜백의 FinishBatch()에서 제거
+    void Clear() {
+        for (Lane& lane : lanes_) {
+            if (lane.queue.size() <= lane.inflight) continue;
+            for (size_t i = lane.inflight; i < lane.queue.size(); ++i) {
+                ForgetEntry(lane.queue[i], lane.front_seq + i);
+            }
+            total_entries_ -= lane.queue.size() - lane.inflight;
+            lane.queue.erase(lane.queue.begin() + static_cast<std::ptrdiff_t>(lane.inflight), lane.queue.end());
+        }
+    }
+};
@@ -0,0 +1,63 @@
+﻿#pragma once
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <google/protobuf/message.h>
+
+#include "../MemoryPool.h"
+#include "SendQueue.h"
+
+// ==========================================
+//   직렬화 1회 공유 패킷 (SharedPacket)
+//
+// [변경 전 문제]
+//   팬아웃(AOI 브로드캐스트) 경로에서 수신자마다 session->Send(pktId, msg) 호출
+//   -> 동일한 메시지를 수신자 수(K)만큼 반복 직렬화 (ByteSizeLong + SerializeToArray × K)
+//   -> BroadcastToGateways도 Gateway 세션 수만큼 반복 직렬화
+//
+// [변경 후]
+//   MakeSharedPacket()으로 [PacketHeader][Payload]를 풀 버퍼에 1회만 직렬화
+//   -> 만들어진 버퍼는 이후 읽기 전용(불변)으로 취급
+//   -> shared_ptr 참조 카운트로 N개 세션의 send_queue_에 그대로 공유
+//   -> 모든 세션의 전송이 끝나면 SendBufferDeleter가 풀에 자동 반납
+//   -> 암호화처럼 세션마다 결과가 달라지는 작업만 수신자별로 수행 (ClientSession::SendShared)
+// ==========================================
+struct SharedPacket {
+    static constexpr uint16_t HEADER_SIZE = sizeof(uint16_t) * 2;
+
+    std::shared_ptr<SendBuffer> buffer;     // [PacketHeader][Payload] (생성 후 수정 금지)
+    uint16_t size = 0;                      // 헤더 포함 전체 크기
+    uint16_t id = 0;
+
+    // 수신 세션 송신 큐 대체 키 (SendQueue::Push 참고, 레인은 수신 세션이 id로 결정)
+    uint64_t coalesce_key = 0;      // 같은 엔티티 식별용 (0 = 대체 안 함)
+
+    bool IsValid() const { return buffer != nullptr && size >= HEADER_SIZE; }
+
+    const char* Payload() const { return buffer->Data() + HEADER_SIZE; }
+    uint16_t PayloadSize() const { return static_cast<uint16_t>(size - HEADER_SIZE); }
+};
+
+// 메시지를 풀 버퍼에 1회 직렬화
+// 크기 초과 시 IsValid() == false인 빈 패킷을 반환 (호출 측에서 로그 처리)
+inline SharedPacket MakeSharedPacket(uint16_t pktId, const google::protobuf::Message& msg) {
+    SharedPacket packet;
+
+    size_t payload_size = msg.ByteSizeLong();
+    size_t total_size = SharedPacket::HEADER_SIZE + payload_size;
+    if (total_size > MAX_PACKET_SIZE) {
+        return packet;
+    }
+
+    SendBuffer* raw_buf = SendBufferPool::GetInstance().Acquire(total_size);
+    packet.buffer = std::shared_ptr<SendBuffer>(raw_buf, SendBufferDeleter());
+    packet.size = static_cast<uint16_t>(total_size);
+    packet.id = pktId;
+
+    char* dst = packet.buffer->Data();
+    std::memcpy(dst, &packet.size, sizeof(uint16_t));
+    std::memcpy(dst + sizeof(uint16_t), &packet.id, sizeof(uint16_t));
+    msg.SerializeToArray(dst + SharedPacket::HEADER_SIZE, static_cast<int>(payload_size));
+
+    return packet;
+}
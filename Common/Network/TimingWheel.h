@@ -0,0 +1,217 @@
+﻿#pragma once
+#include <boost/asio.hpp>
+#include <array>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <atomic>
+
+#include "../Utils/Lock.h"
+
+// ==========================================
+//   계층형 타이밍 휠 (세션 타이머 공용 서비스)
+//
+// [변경 전 문제]
+//   세션마다 steady_timer를 1개씩 보유하고 주기마다 expires_after + async_wait
+//   -> 1만 세션 = Asio 타이머 힙에 타이머 1만 개 (재무장마다 O(log N) + 힙 락 경합)
+//   -> 세션 생성/종료마다 타이머 객체 할당/해제
+//
+// [변경 후]
+//   프로세스당 휠 1개를 steady_timer 1개로 tick_ 간격마다 진행
+//   -> Schedule()은 슬롯 vector에 push_back 1회 (O(1), 세션별 타이머 객체 없음)
+//   -> LEVEL_COUNT단 × SLOT_COUNT칸 계층 구조: 가까운 만기는 0단, 먼 만기는 상위 단에
+//      두었다가 하위 단 한 바퀴마다 내려보냄(cascade)
+//      (tick 100ms 기준 0단 6.4초, 1단 약 7분, 2단 약 7시간, 3단 약 19일)
+//   -> 만기 해상도는 tick 단위 (세션 하트비트/유휴 감시/봇 행동 주기 용도로 충분)
+//
+// [콜백 규칙]
+//   콜백은 휠의 io_context 스레드에서 락 밖으로 실행됩니다.
+//   세션 상태는 만지지 말고 weak_ptr로 세션을 확인한 뒤 세션 strand로 post만 하세요.
+//   개별 취소 API는 두지 않음 -> 세션 쪽에서 세대(generation)/종료 플래그로 무시
+//   (세션당 대기 엔트리는 항상 1개이므로 취소 없이도 메모리는 세션 수에 비례)
+//
+// [사용 예]
+//   TimingWheel::GetInstance().Start(io_context, std::chrono::milliseconds(100));
+//   TimingWheel::ShutdownGuard wheel_guard;    // io_context보다 나중에 선언 (먼저 소멸)
+//   std::weak_ptr<Session> weak = shared_from_this();
+//   TimingWheel::GetInstance().Schedule(std::chrono::seconds(15), [weak]() {
+//       if (auto self = weak.lock()) boost::asio::post(self->strand_, [self]() { ... });
+//   });
+// ==========================================
+class TimingWheel {
+public:
+    using Callback = std::function<void()>;
+
+private:
+    static constexpr uint32_t SLOT_BITS = 6;
+    static constexpr uint32_t SLOT_COUNT = 1u << SLOT_BITS;
+    static constexpr uint64_t SLOT_MASK = SLOT_COUNT - 1;
+    static constexpr uint32_t LEVEL_COUNT = 4;
+
+    struct Node {
+        uint64_t expire_tick;
+        Callback callback;
+    };
+
+    using Slot = std::vector<Node>;
+
+    std::array<std::array<Slot, SLOT_COUNT>, LEVEL_COUNT> wheel_;
+    uint64_t current_tick_ = 0;
+    size_t pending_ = 0;
+    UTILITY::Lock mutex_;
+
+    std::unique_ptr<boost::asio::steady_timer> timer_;
+    std::chrono::steady_clock::duration tick_ = std::chrono::milliseconds(100);
+    std::chrono::steady_clock::time_point next_tick_time_;
+    std::atomic<bool> stopped_{ false };
+
+    std::vector<Node> due_;     // 만기 콜백 실행용 (tick 스레드 전용, 용량 재사용)
+
+    static constexpr uint64_t LevelSpan(uint32_t level) {
+        return uint64_t(1) << (SLOT_BITS * level);
+    }
+
+    // mutex_ 보유 상태에서 호출, node.expire_tick >= current_tick_ 이어야 함
+    void InsertLocked(Node&& node) {
+        uint64_t delta = node.expire_tick - current_tick_;
+        for (uint32_t level = 0; level < LEVEL_COUNT; ++level) {
+            bool last = (level == LEVEL_COUNT - 1);
+            if (delta < LevelSpan(level + 1) || last) {
+                // 최상위 단 범위를 넘는 만기는 가장 먼 칸에 두고, 내려올 때마다 다시 배치
+                uint64_t at = (last && delta >= LevelSpan(LEVEL_COUNT))
+                    ? current_tick_ + LevelSpan(LEVEL_COUNT) - 1
+                    : node.expire_tick;
+                wheel_[level][(at >> (SLOT_BITS * level)) & SLOT_MASK].push_back(std::move(node));
+                return;
+            }
+        }
+    }
+
+    // tick 1칸 진행: 상위 단 cascade 후 0단 현재 칸을 due_로 꺼냄 (mutex_ 보유 상태)
+    void AdvanceLocked() {
+        ++current_tick_;
+
+        for (uint32_t level = 1; level < LEVEL_COUNT; ++level) {
+            if ((current_tick_ & (LevelSpan(level) - 1)) != 0) break;
+
+            Slot moving;
+            moving.swap(wheel_[level][(current_tick_ >> (SLOT_BITS * level)) & SLOT_MASK]);
+            for (auto& node : moving) InsertLocked(std::move(node));
+        }
+
+        Slot& slot = wheel_[0][current_tick_ & SLOT_MASK];
+        pending_ -= slot.size();
+        for (auto& node : slot) due_.push_back(std::move(node));
+        slot.clear();   // 용량 유지 (다음 바퀴 재사용)
+    }
+
+    void ArmTimer() {
+        next_tick_time_ += tick_;
+        timer_->expires_at(next_tick_time_);
+        timer_->async_wait([this](boost::system::error_code ec) {
+            if (ec || stopped_.load(std::memory_order_acquire)) return;
+            OnTimer();
+        });
+    }
+
+    void OnTimer() {
+        // 타이머 지연(부하) 시 밀린 tick을 한 번에 따라잡음
+        auto now = std::chrono::steady_clock::now();
+        int64_t behind = (now - next_tick_time_) / tick_;
+        uint64_t steps = 1 + static_cast<uint64_t>(behind > 0 ? behind : 0);
+
+        {
+            UTILITY::LockGuard lock(mutex_);
+            for (uint64_t i = 0; i < steps; ++i) AdvanceLocked();
+        }
+        next_tick_time_ += tick_ * static_cast<int64_t>(steps - 1);
+
+        for (auto& node : due_) {
+            if (node.callback) node.callback();
+        }
+        due_.clear();
+
+        if (!stopped_.load(std::memory_order_acquire)) ArmTimer();
+    }
+
+public:
+    static TimingWheel& GetInstance() {
+        static TimingWheel instance;
+        return instance;
+    }
+
+    TimingWheel() = default;
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    // 휠 가동: io_context.run() 전에 1회 호출 (tick 타이머가 이 io_context에서 돎)
+    void Start(boost::asio::io_context& io_context, std::chrono::steady_clock::duration tick) {
+        if (timer_) return;
+        stopped_.store(false, std::memory_order_release);
+        if (tick > std::chrono::steady_clock::duration::zero()) tick_ = tick;
+        timer_ = std::make_unique<boost::asio::steady_timer>(io_context);
+        next_tick_time_ = std::chrono::steady_clock::now();
+        ArmTimer();
+    }
+
+    // 휠 정지 (콜백 안에서 호출해도 안전, 대기 중인 엔트리는 실행되지 않음)
+    void Stop() {
+        stopped_.store(true, std::memory_order_release);
+        if (timer_) timer_->cancel();
+    }
+
+    // ==========================================
+    //   휠 해제 - io_context 소멸 전에 호출
+    //
+    // 휠은 함수 static 싱글톤이라 main()의 io_context보다 오래 삶
+    //   -> timer_를 남겨두면 정적 소멸 시점에 이미 사라진 io_context에 타이머를 반납 (use-after-free)
+    // io_context 스레드가 모두 끝난 뒤(run() 반환/Join 후) 호출:
+    //   timer_ 취소 + 해제, 대기 엔트리 전부 폐기 (콜백은 실행되지 않음)
+    // ==========================================
+    void Shutdown() {
+        Stop();
+        timer_.reset();
+
+        // 콜백 캡처(세션 포인터 등)의 소멸이 Schedule()을 다시 부를 수 있으므로 락 밖에서 파괴
+        std::vector<Slot> dropped;
+        {
+            UTILITY::LockGuard lock(mutex_);
+            dropped.reserve(LEVEL_COUNT * SLOT_COUNT);
+            for (auto& level : wheel_) {
+                for (auto& slot : level) {
+                    dropped.emplace_back();
+                    dropped.back().swap(slot);
+                }
+            }
+            pending_ = 0;
+        }
+        due_.clear();
+    }
+
+    // main()에서 io_context(또는 IoContextPool) 뒤에 선언 -> 스코프를 벗어날 때(예외 포함) 먼저 Shutdown
+    struct ShutdownGuard {
+        ShutdownGuard() = default;
+        ~ShutdownGuard() { TimingWheel::GetInstance().Shutdown(); }
+        ShutdownGuard(const ShutdownGuard&) = delete;
+        ShutdownGuard& operator=(const ShutdownGuard&) = delete;
+    };
+
+    // delay 후 callback 1회 실행 (어느 스레드에서나 호출 가능, 최소 1 tick 뒤)
+    //   -> 만기 시각은 tick 경계로 맞춰지므로 실제 지연은 delay ± 1 tick
+    template<typename Rep, typename Period>
+    void Schedule(std::chrono::duration<Rep, Period> delay, Callback callback) {
+        auto ticks = std::chrono::duration_cast<std::chrono::steady_clock::duration>(delay) / tick_;
+        uint64_t after = ticks > 0 ? static_cast<uint64_t>(ticks) : 1;
+
+        UTILITY::LockGuard lock(mutex_);
+        InsertLocked(Node{ current_tick_ + after, std::move(callback) });
+        ++pending_;
+    }
+
+    size_t GetPendingCount() {
+        UTILITY::LockGuard lock(mutex_);
+        return pending_;
+    }
+};
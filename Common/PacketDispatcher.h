@@ -5,8 +5,15 @@
 #include <iostream>
 #include <chrono>
 #include <atomic>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+#include <type_traits>
 
 #include "Define/SecurityConstants.h"
+#include "Network/PacketArena.h"
 
 // ==========================================
 // PacketDispatcher: 패킷 유효성 검증 및 Rate Limiting 추가
@@ -16,7 +23,7 @@
 //   -> 서버 자원 고갈 공격(DoS)에 취약
 //
 // [변경 후]
-//   1. HasHandler(): 패킷 ID 등록 여부 사전 검증 (ReadPayload에서 호출)
+//   1. Find()/HasHandler(): 패킷 ID 등록 여부 사전 검증 (ReadPayload에서 호출)
 //   2. Dispatch()에서 핸들러 존재 확인 및 로그 출력
 //   3. RateLimiter: 세션별 초당 패킷 제한 (Token Bucket 방식)
 //      -> 기본 MAX_PACKETS_PER_SECOND = 200, 초과 시 패킷 드랍
@@ -88,41 +95,243 @@ public:
     int GetViolationCount() const { return violation_count_; }
 };
 
+// ==========================================
+//   PacketDispatcher - 패킷 ID 직접 인덱싱 테이블 + 핸들러별 계측
+//
+// 변경 전: std::unordered_map<uint16_t, std::function<...>>
+//   -> ClientSession은 HasHandler()와 Dispatch()에서 해시 조회 2회
+//   -> 모든 패킷이 std::function 간접 호출을 거침
+//
+// 변경 후: 패킷 ID를 그대로 인덱스로 쓰는 고정 배열 (MAX_PACKET_ID 미만)
+//   -> 조회는 경계 검사 + 배열 접근 1회, Find()로 얻은 엔트리를 Invoke()에 재사용
+//   -> RegisterHandler<&Func>(id): 컴파일 타임 등록 형태
+//      핸들러마다 전용 썽크(InvokeStatic<&Func>)를 생성해 엔트리에 저장
+//      -> 썽크 안에서는 Func가 컴파일 타임 상수이므로 직접 호출되고 인라인 가능
+//      -> 패킷당 간접 호출은 썽크 1회뿐 (std::function 경유 없음, 런타임 등록과 혼용 가능)
+//   -> 엔트리마다 호출 횟수/누적 처리 시간 카운터 (relaxed atomic, 스레드 간 공유)
+//
+// [타입 명령 모드] RegisterCommand<Cmd, &Decode, &Execute>(id)
+//   Decode: 페이로드 -> 평범한 명령 구조체(Cmd) 변환 + 검증, 수신 I/O 스레드에서 실행
+//   Execute: 디코딩된 Cmd 처리, 직렬 strand(game_strand_ 등)에서 실행
+//   -> 수신 측이 DecodeCommand()로 미리 풀어 strand에는 Cmd 바이트만 넘기고 InvokeCommand()로 실행
+//   -> Cmd는 trivially copyable + MAX_COMMAND_BYTES 이하 (배치 버퍼에 바이트 그대로 복사)
+//   -> 원본 페이로드로 Dispatch()/Invoke()해도 그 자리에서 디코딩 후 실행 (경로 무관하게 동작)
+//
+// [스레드 안전성]
+//   등록은 서버 초기화 시 메인 스레드에서만 수행, 이후 테이블은 읽기 전용
+// ==========================================
 template <typename SessionType>
 class PacketDispatcher {
 public:
     using HandlerFunc = std::function<void(std::shared_ptr<SessionType>&, char*, uint16_t)>;
+    using RawHandler = void(*)(std::shared_ptr<SessionType>&, char*, uint16_t);
+
+    using DecodeFunc = bool(*)(const char*, uint16_t, void*);
+    using ExecuteFunc = void(*)(std::shared_ptr<SessionType>&, const char*);
+
+    struct Entry;
+    using InvokeFunc = void(*)(Entry&, std::shared_ptr<SessionType>&, char*, uint16_t);
+
+    // protocol.proto의 패킷 ID 범위(클라이언트 0~, S2S 1000~)를 모두 덮는 크기
+    static constexpr uint16_t MAX_PACKET_ID = 2048;
+
+    // 타입 명령 구조체 최대 크기 (디코딩용 스택 버퍼 크기)
+    static constexpr uint16_t MAX_COMMAND_BYTES = 128;
+
+    struct Entry {
+        InvokeFunc invoke = nullptr;    // 등록 형태별 썽크 (원본 페이로드 실행 + 계측)
+        HandlerFunc func;               // 런타임 등록 (람다 등)
+        DecodeFunc decode = nullptr;    // 타입 명령 모드 (I/O 스레드 디코딩)
+        ExecuteFunc execute = nullptr;  // 타입 명령 모드 (strand 실행)
+        uint16_t command_size = 0;
+        std::atomic<uint64_t> calls{ 0 };
+        std::atomic<uint64_t> elapsed_ns{ 0 };
+
+        bool IsSet() const { return invoke != nullptr; }
+        bool IsCommand() const { return execute != nullptr; }
+    };
+
+    // 디코딩 결과를 담는 정렬된 스택 버퍼
+    struct CommandBuffer {
+        alignas(std::max_align_t) char bytes[MAX_COMMAND_BYTES];
+    };
+
+    // 핸들러별 누적 지표 (GetStats 결과)
+    struct HandlerStats {
+        uint16_t pkt_id;
+        uint64_t calls;
+        uint64_t elapsed_ns;
+    };
 
 private:
-    std::unordered_map<uint16_t, HandlerFunc> handlers_;
+    std::unique_ptr<Entry[]> entries_{ new Entry[MAX_PACKET_ID] };
+    size_t handler_count_ = 0;
+
+    static void Record(Entry& entry, std::chrono::steady_clock::time_point start) {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+
+        entry.calls.fetch_add(1, std::memory_order_relaxed);
+        entry.elapsed_ns.fetch_add(static_cast<uint64_t>(ns), std::memory_order_relaxed);
+    }
+
+    Entry* Slot(uint16_t pktId) {
+        if (pktId >= MAX_PACKET_ID) {
+            std::cerr << "[PacketDispatcher] 패킷 ID 범위 초과로 등록 실패: " << pktId
+                      << " (MAX_PACKET_ID=" << MAX_PACKET_ID << ")\n";
+            return nullptr;
+        }
+        Entry& entry = entries_[pktId];
+        if (!entry.IsSet()) ++handler_count_;
+        entry.invoke = nullptr;
+        entry.func = nullptr;
+        entry.decode = nullptr;
+        entry.execute = nullptr;
+        entry.command_size = 0;
+        return &entry;
+    }
+
+    // ---- 등록 형태별 썽크 (Entry::invoke) ----
+
+    // 런타임 등록: std::function 경유
+    static void InvokeFunction(Entry& entry, std::shared_ptr<SessionType>& session, char* payload, uint16_t payloadSize) {
+        PacketArena::BatchScope arena_scope;
+        auto start = std::chrono::steady_clock::now();
+        entry.func(session, payload, payloadSize);
+        Record(entry, start);
+    }
+
+    // 컴파일 타임 등록: Handler가 템플릿 인자(상수)이므로 직접 호출 + 인라인 대상
+    template <RawHandler Handler>
+    static void InvokeStatic(Entry& entry, std::shared_ptr<SessionType>& session, char* payload, uint16_t payloadSize) {
+        PacketArena::BatchScope arena_scope;
+        auto start = std::chrono::steady_clock::now();
+        Handler(session, payload, payloadSize);
+        Record(entry, start);
+    }
+
+    // 타입 명령이 원본 페이로드로 들어온 경우: 이 자리에서 디코딩 후 실행 (Decode/Execute 모두 직접 호출)
+    template <typename Cmd,
+              bool (*Decode)(const char*, uint16_t, Cmd&),
+              void (*Execute)(std::shared_ptr<SessionType>&, const Cmd&)>
+    static void InvokeDecoded(Entry& entry, std::shared_ptr<SessionType>& session, char* payload, uint16_t payloadSize) {
+        PacketArena::BatchScope arena_scope;
+        Cmd cmd;
+        if (!Decode(payload, payloadSize, cmd)) return;
+
+        auto start = std::chrono::steady_clock::now();
+        Execute(session, cmd);
+        Record(entry, start);
+    }
 
 public:
     // 패킷 핸들러 등록 (서버 초기화 시 메인 스레드에서만 호출되므로 락 불필요)
     void RegisterHandler(uint16_t pktId, HandlerFunc handler) {
-        handlers_[pktId] = handler;
+        if (Entry* entry = Slot(pktId)) {
+            entry->func = std::move(handler);
+            entry->invoke = &InvokeFunction;
+        }
+    }
+
+    // 컴파일 타임 등록: RegisterHandler<&Handle_MoveReq>(PKT_...)
+    template <RawHandler Handler>
+    void RegisterHandler(uint16_t pktId) {
+        if (Entry* entry = Slot(pktId)) entry->invoke = &InvokeStatic<Handler>;
+    }
+
+    // 타입 명령 등록: RegisterCommand<MoveCommand, &Decode_MoveReq, &Handle_MoveReq>(PKT_...)
+    template <typename Cmd,
+              bool (*Decode)(const char*, uint16_t, Cmd&),
+              void (*Execute)(std::shared_ptr<SessionType>&, const Cmd&)>
+    void RegisterCommand(uint16_t pktId) {
+        static_assert(std::is_trivially_copyable<Cmd>::value, "명령 구조체는 바이트 복사 가능해야 함");
+        static_assert(sizeof(Cmd) <= MAX_COMMAND_BYTES, "명령 구조체가 MAX_COMMAND_BYTES를 초과함");
+
+        if (Entry* entry = Slot(pktId)) {
+            entry->decode = [](const char* payload, uint16_t size, void* out) {
+                return Decode(payload, size, *static_cast<Cmd*>(out));
+            };
+            entry->execute = [](std::shared_ptr<SessionType>& session, const char* bytes) {
+                Cmd cmd;
+                std::memcpy(&cmd, bytes, sizeof(Cmd));
+                Execute(session, cmd);
+            };
+            entry->command_size = static_cast<uint16_t>(sizeof(Cmd));
+            entry->invoke = &InvokeDecoded<Cmd, Decode, Execute>;
+        }
+    }
+
+    // 등록된 핸들러 엔트리 조회 (미등록이면 nullptr)
+    Entry* Find(uint16_t pktId) const {
+        if (pktId >= MAX_PACKET_ID) return nullptr;
+        Entry* entry = &entries_[pktId];
+        return entry->IsSet() ? entry : nullptr;
     }
 
-    // 패킷 ID에 대한 핸들러 등록 여부 확인 (ReadHeader에서 사전 검증용)
+    // 패킷 ID에 대한 핸들러 등록 여부 확인
     bool HasHandler(uint16_t pktId) const {
-        return handlers_.find(pktId) != handlers_.end();
+        return Find(pktId) != nullptr;
     }
 
     // 등록된 핸들러 수 반환 (디버깅용)
     size_t GetHandlerCount() const {
-        return handlers_.size();
+        return handler_count_;
+    }
+
+    // Find()로 얻은 엔트리 실행 + 계측 (조회 1회로 검증과 분배를 함께 처리)
+    //   -> 핸들러가 PacketArena::Create<T>()로 만든 메시지는 바깥 배치 스코프가 없으면 썽크에서 회수
+    static void Invoke(Entry& entry, std::shared_ptr<SessionType>& session, char* payload, uint16_t payloadSize) {
+        entry.invoke(entry, session, payload, payloadSize);
+    }
+
+    // 타입 명령 디코딩 (수신 I/O 스레드, 실패 시 호출 측에서 프레임 폐기)
+    static bool DecodeCommand(const Entry& entry, const char* payload, uint16_t payloadSize, CommandBuffer& out) {
+        return entry.decode(payload, payloadSize, out.bytes);
+    }
+
+    // 디코딩된 명령 실행 + 계측 (strand, bytes는 command_size 바이트)
+    static void InvokeCommand(Entry& entry, std::shared_ptr<SessionType>& session, const char* bytes) {
+        auto start = std::chrono::steady_clock::now();
+        entry.execute(session, bytes);
+        Record(entry, start);
     }
 
     // 패킷 분배 (읽기 전용이므로 멀티스레드 환경에서도 안전함)
     void Dispatch(std::shared_ptr<SessionType>& session, uint16_t pktId, char* payload, uint16_t payloadSize) {
-        auto it = handlers_.find(pktId);
-        if (it != handlers_.end()) {
-            if (it->second) {
-                it->second(session, payload, payloadSize);
-            }
+        if (Entry* entry = Find(pktId)) {
+            Invoke(*entry, session, payload, payloadSize);
         }
         else {
             std::cerr << "[PacketDispatcher] 등록되지 않은 패킷 ID 수신: " << pktId
                       << " (payloadSize=" << payloadSize << ") - 무시됨\n";
         }
     }
+
+    // 호출된 적 있는 핸들러의 누적 지표 (누적 처리 시간 내림차순)
+    std::vector<HandlerStats> GetStats() const {
+        std::vector<HandlerStats> stats;
+        for (uint16_t id = 0; id < MAX_PACKET_ID; ++id) {
+            const Entry& entry = entries_[id];
+            uint64_t calls = entry.calls.load(std::memory_order_relaxed);
+            if (calls == 0) continue;
+            stats.push_back({ id, calls, entry.elapsed_ns.load(std::memory_order_relaxed) });
+        }
+        std::sort(stats.begin(), stats.end(), [](const HandlerStats& a, const HandlerStats& b) {
+            return a.elapsed_ns > b.elapsed_ns;
+        });
+        return stats;
+    }
+
+    // 상위 top_n개 핸들러 요약 문자열: "id:호출수/평균us, ..."
+    std::string FormatTopStats(size_t top_n) const {
+        std::string out;
+        auto stats = GetStats();
+        for (size_t i = 0; i < stats.size() && i < top_n; ++i) {
+            if (!out.empty()) out += ", ";
+            uint64_t avg_us = stats[i].elapsed_ns / stats[i].calls / 1000;
+            out += std::to_string(stats[i].pkt_id) + ":" + std::to_string(stats[i].calls)
+                + "/" + std::to_string(avg_us) + "us";
+        }
+        return out;
+    }
 };
@@ -126,6 +126,8 @@ bool ProcessWorldSelect(tcp::socket& socket, std::string& out_token, std::string
 // =======================================================
 std::thread StartReceiveThread(tcp::socket& socket, const std::string& my_id, float& my_x, float& my_y, int& my_hp, std::unordered_map<std::string, std::pair<float, float>>& monster_pos_map) {
     std::thread recv_thread([&socket, my_id, &my_x, &my_y, &my_hp, &monster_pos_map]() {
+        // 압축 이동 코덱 복원 상태 (수신 스레드 전용)
+        MoveCodec::ClientDecoder move_decoder;
         try {
             while (true) {
                 PacketHeader h;
@@ -155,6 +157,14 @@ std::thread StartReceiveThread(tcp::socket& socket, const std::string& my_id, fl
                 {
                     HandleMoveRes(p, my_id, my_x, my_y, my_hp, monster_pos_map);
                 }
+                else if (h.id == Protocol::PKT_GATEWAY_CLIENT_MOVE_KEYFRAME)
+                {
+                    HandleMoveKeyframe(p, move_decoder, my_id, my_x, my_y, my_hp, monster_pos_map);
+                }
+                else if (h.id == Protocol::PKT_GATEWAY_CLIENT_MOVE_DELTA)
+                {
+                    HandleMoveDelta(p, move_decoder, my_id, my_x, my_y, my_hp, monster_pos_map);
+                }
                 else if (h.id == Protocol::PKT_GATEWAY_CLIENT_ATTACK_RES)
                 {
                     HandleAttackRes(p, my_id, my_x, my_y, my_hp, monster_pos_map);
@@ -268,6 +278,7 @@ int main() {
         Protocol::GatewayConnectReq gw_req;
         gw_req.set_account_id(my_id);
         gw_req.set_session_token(session_token);
+        gw_req.set_move_codec_flags(MoveCodec::FLAG_COMPACT_MOVE);   // 압축 이동 코덱 지원
         SendPacket(socket, Protocol::PKT_CLIENT_GATEWAY_CONNECT_REQ, gw_req);  // crypto 미전달 = 평문
 
         PacketHeader res_header;
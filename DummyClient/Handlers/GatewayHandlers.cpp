@@ -8,59 +8,97 @@
 #include <iostream>
 #include <cmath>
 
-void HandleMoveRes(const std::vector<char>& p, const std::string& my_id, float& my_x, float& my_y, int& my_hp, std::unordered_map<std::string, std::pair<float, float>>& monster_pos_map) {
-    Protocol::MoveRes move_res;
-    if (move_res.ParseFromArray(p.data(), p.size())) {
-        
-        if (move_res.account_id() == my_id) {
-            float distance = std::sqrt(std::pow(my_x - move_res.x(), 2) + std::pow(my_y - move_res.y(), 2));
-            if (distance > 0.1f) {
-                my_x = move_res.x();
-                my_y = move_res.y();
-                if (my_x == 0.0f && my_y == 0.0f && my_hp <= 0) {
-                    my_hp = 100;
-                    std::cout << "\n✨ [System] 기절하여 서버에 의해 마을로 강제 이동(부활) 되었습니다!\n";
-                }
-                else {
-                    std::cout << "\n🚧 [System] 맵의 경계에 도달하여 위치가 보정되었습니다.\n";
-                }
-                std::cout << "[내 정보] HP: " << my_hp << " | 위치 X:" << my_x << " Y:" << my_y << "          \r";
+static void ApplyMoveRes(const Protocol::MoveRes& move_res, const std::string& my_id, float& my_x, float& my_y, int& my_hp, std::unordered_map<std::string, std::pair<float, float>>& monster_pos_map) {
+    if (move_res.account_id() == my_id) {
+        float distance = std::sqrt(std::pow(my_x - move_res.x(), 2) + std::pow(my_y - move_res.y(), 2));
+        if (distance > 0.1f) {
+            my_x = move_res.x();
+            my_y = move_res.y();
+            if (my_x == 0.0f && my_y == 0.0f && my_hp <= 0) {
+                my_hp = 100;
+                std::cout << "\n✨ [System] 기절하여 서버에 의해 마을로 강제 이동(부활) 되었습니다!\n";
+            }
+            else {
+                std::cout << "\n🚧 [System] 맵의 경계에 도달하여 위치가 보정되었습니다.\n";
             }
+            std::cout << "[내 정보] HP: " << my_hp << " | 위치 X:" << my_x << " Y:" << my_y << "          \r";
         }
-        else if (move_res.account_id().find("MONSTER_") == 0) {
-            std::string mon_id = move_res.account_id();
-            float m_x = move_res.x();
-            float m_y = move_res.y();
+    }
+    else if (move_res.account_id().find("MONSTER_") == 0) {
+        std::string mon_id = move_res.account_id();
+        float m_x = move_res.x();
+        float m_y = move_res.y();
 
-            float dist_to_player = std::sqrt(std::pow(my_x - m_x, 2) + std::pow(my_y - m_y, 2));
+        float dist_to_player = std::sqrt(std::pow(my_x - m_x, 2) + std::pow(my_y - m_y, 2));
 
-            bool is_respawn = false;
+        bool is_respawn = false;
 
-            // 넘겨받은 지역 변수 맵(monster_pos_map)을 안전하게 사용합니다.
-            if (monster_pos_map.find(mon_id) == monster_pos_map.end()) {
-                is_respawn = true;
-            }
-            else {
-                float last_x = monster_pos_map[mon_id].first;
-                float last_y = monster_pos_map[mon_id].second;
-                float dist_from_last = std::sqrt(std::pow(last_x - m_x, 2) + std::pow(last_y - m_y, 2));
+        // 넘겨받은 지역 변수 맵(monster_pos_map)을 안전하게 사용합니다.
+        if (monster_pos_map.find(mon_id) == monster_pos_map.end()) {
+            is_respawn = true;
+        }
+        else {
+            float last_x = monster_pos_map[mon_id].first;
+            float last_y = monster_pos_map[mon_id].second;
+            float dist_from_last = std::sqrt(std::pow(last_x - m_x, 2) + std::pow(last_y - m_y, 2));
 
-                if (dist_from_last > 2.0f) {
-                    is_respawn = true;
-                }
+            if (dist_from_last > 2.0f) {
+                is_respawn = true;
             }
+        }
 
-            monster_pos_map[mon_id] = { m_x, m_y };
+        monster_pos_map[mon_id] = { m_x, m_y };
 
-            if (is_respawn && dist_to_player <= 0.1f) {
-                std::cout << "\n⚠️ [System] 앗! 당신이 서 있는 좌표(X:" << my_x << ", Y:" << my_y
-                    << ")에 " << mon_id << " 가 리스폰(등장)했습니다!\n";
-                std::cout << "[내 정보] HP: " << my_hp << " | 위치 X:" << my_x << " Y:" << my_y << "          \r";
-            }
+        if (is_respawn && dist_to_player <= 0.1f) {
+            std::cout << "\n⚠️ [System] 앗! 당신이 서 있는 좌표(X:" << my_x << ", Y:" << my_y
+                << ")에 " << mon_id << " 가 리스폰(등장)했습니다!\n";
+            std::cout << "[내 정보] HP: " << my_hp << " | 위치 X:" << my_x << " Y:" << my_y << "          \r";
         }
     }
 }
 
+void HandleMoveRes(const std::vector<char>& p, const std::string& my_id, float& my_x, float& my_y, int& my_hp, std::unordered_map<std::string, std::pair<float, float>>& monster_pos_map) {
+    Protocol::MoveRes move_res;
+    if (move_res.ParseFromArray(p.data(), p.size())) {
+        ApplyMoveRes(move_res, my_id, my_x, my_y, my_hp, monster_pos_map);
+    }
+}
+
+// ==========================================
+//   압축 이동 코덱 수신
+//
+// 키프레임: 엔티티별 기준 좌표 (처음 보는 엔티티면 account_id 포함)
+// 델타:     마지막으로 받은 키프레임 대비 차이 (바이너리)
+// 복원한 값은 기존 MoveRes 처리 경로(ApplyMoveRes)로 그대로 넘깁니다.
+// ==========================================
+static void ApplyDecodedMove(const MoveCodec::ClientDecoder::Move& move, const std::string& my_id, float& my_x, float& my_y, int& my_hp, std::unordered_map<std::string, std::pair<float, float>>& monster_pos_map) {
+    Protocol::MoveRes move_res;
+    move_res.set_account_id(move.account_id);
+    move_res.set_x(move.x);
+    move_res.set_y(move.y);
+    move_res.set_z(move.z);
+    move_res.set_yaw(move.yaw);
+    ApplyMoveRes(move_res, my_id, my_x, my_y, my_hp, monster_pos_map);
+}
+
+void HandleMoveKeyframe(const std::vector<char>& p, MoveCodec::ClientDecoder& decoder, const std::string& my_id, float& my_x, float& my_y, int& my_hp, std::unordered_map<std::string, std::pair<float, float>>& monster_pos_map) {
+    Protocol::MoveKeyframe key;
+    if (!key.ParseFromArray(p.data(), p.size())) return;
+
+    MoveCodec::ClientDecoder::Move move;
+    if (decoder.OnKeyframe(key.entity(), key.account_id(), key.qx(), key.qy(), key.qz(),
+                           static_cast<uint8_t>(key.yaw()), move)) {
+        ApplyDecodedMove(move, my_id, my_x, my_y, my_hp, monster_pos_map);
+    }
+}
+
+void HandleMoveDelta(const std::vector<char>& p, MoveCodec::ClientDecoder& decoder, const std::string& my_id, float& my_x, float& my_y, int& my_hp, std::unordered_map<std::string, std::pair<float, float>>& monster_pos_map) {
+    MoveCodec::ClientDecoder::Move move;
+    if (decoder.OnDelta(p.data(), p.size(), move)) {
+        ApplyDecodedMove(move, my_id, my_x, my_y, my_hp, monster_pos_map);
+    }
+}
+
 void HandleAttackRes(const std::vector<char>& p, const std::string& my_id, float& my_x, float& my_y, int& my_hp, std::unordered_map<std::string, std::pair<float, float>>& monster_pos_map) {
     Protocol::AttackRes attack_res;
     if (attack_res.ParseFromArray(p.data(), p.size())) {
@@ -3,9 +3,15 @@
 #include <string>
 #include <unordered_map>
 
+#include "..\..\Common\Network\MoveCodec.h"
+
 // =======================================================
 // [Gateway -> Client 패킷 수신 핸들러]
 // =======================================================
 
 void HandleMoveRes(const std::vector<char>& p, const std::string& my_id, float& my_x, float& my_y, int& my_hp, std::unordered_map<std::string, std::pair<float, float>>& monster_pos_map);
+
+// 압축 이동 코덱 (GatewayConnectRes.move_codec_flags 협상 시) -> 복원 후 MoveRes와 동일하게 처리
+void HandleMoveKeyframe(const std::vector<char>& p, MoveCodec::ClientDecoder& decoder, const std::string& my_id, float& my_x, float& my_y, int& my_hp, std::unordered_map<std::string, std::pair<float, float>>& monster_pos_map);
+void HandleMoveDelta(const std::vector<char>& p, MoveCodec::ClientDecoder& decoder, const std::string& my_id, float& my_x, float& my_y, int& my_hp, std::unordered_map<std::string, std::pair<float, float>>& monster_pos_map);
 void HandleAttackRes(const std::vector<char>& p, const std::string& my_id, float& my_x, float& my_y, int& my_hp, std::unordered_map<std::string, std::pair<float, float>>& monster_pos_map);
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include "../Common/Utils/Logger.h"
 #include "../Common/Redis/RedisManager.h"
 #include "../Common/MemoryPool.h"
+#include "../Common/Network/SendQueue.h"
 #include "Pathfinder/MapGenerator.h"
 #include "Monster/MonsterManager.h"
 
@@ -65,13 +66,146 @@ private:
     }
 };
 
+// ==========================================
+//   BroadcastToGateways - 직렬화 1회 팬아웃
+//
+// 변경 전: Gateway 세션마다 session->Send(pktId, msg) -> 세션 수만큼 반복 직렬화
+// 변경 후: 락 밖에서 1회 직렬화한 공유 버퍼를 모든 세션의 send_queue_에 넣음
+// ==========================================
 void GameContext::BroadcastToGateways(uint16_t pktId, const google::protobuf::Message& msg) {
+    SharedPacket packet = MakeSharedPacket(pktId, msg);
+    if (!packet.IsValid()) {
+        LOG_ERROR("GameServer", "BroadcastToGateways 패킷 크기 초과 (PktID: " << pktId << ") - 전송 취소");
+        return;
+    }
+
     UTILITY::LockGuard lock(gatewaySessionMutex);
     for (auto& session : gatewaySessions) {
-        if (session) {
-            session->Send(pktId, msg);
+        // Gateway당 대표 레인 1개로만 전송 (다중 레인 중복 전달 방지)
+        if (session && session->IsPrimaryLane()) {
+            session->SendShared(packet);
+        }
+    }
+}
+
+// ==========================================
+//   GameOutputStage - 출력 이벤트 인코딩 단계 (GameOutput.h 참고)
+// ==========================================
+GameOutputStage::GameOutputStage(boost::asio::io_context& io_context)
+    : encode_strand_(io_context) { }
+
+GameOutputStage::~GameOutputStage() {
+    pending_.reset();
+    for (OutputBatch* batch : free_batches_) delete batch;
+}
+
+void GameOutputStage::ScheduleFlush() {
+    flush_scheduled_ = true;
+    boost::asio::post(GameContext::Get().game_strand_, [this]() {
+        flush_scheduled_ = false;
+        Flush();
+    });
+}
+
+void GameOutputStage::Flush() {
+    if (!pending_ || pending_->Empty()) return;
+
+    std::shared_ptr<OutputBatch> batch = std::move(pending_);
+    boost::asio::post(encode_strand_, [this, batch]() {
+        Encode(*batch);
+    });
+}
+
+// encode_strand_에서 실행: 대표 레인 경로표 갱신 (배치당 gatewaySessionMutex 1회)
+void GameOutputStage::RefreshRoutes() {
+    routes_.clear();
+
+    auto& ctx = GameContext::Get();
+    UTILITY::LockGuard lock(ctx.gatewaySessionMutex);
+    for (auto& session : ctx.gatewaySessions) {
+        // Gateway당 대표 레인 1개로만 전송 (다중 레인 중복 전달 방지)
+        if (session && session->IsPrimaryLane()) {
+            routes_.push_back({ session->GetGatewayId(), session });
+        }
+    }
+}
+
+template <typename Msg>
+void GameOutputStage::Route(uint16_t pkt_id, Msg& msg, const uint32_t* handles, uint32_t count) {
+    // Gateway 수는 한 자릿수이므로 경로마다 핸들 목록을 한 번씩 훑어 자기 몫만 채움
+    for (const GatewayRoute& route : routes_) {
+        msg.clear_target_handles();
+        for (uint32_t i = 0; i < count; ++i) {
+            if (GatewayOf(handles[i]) == route.gateway_id) msg.add_target_handles(handles[i]);
+        }
+        if (msg.target_handles_size() == 0) continue;
+
+        SharedPacket packet = MakeSharedPacket(pkt_id, msg);
+        if (!packet.IsValid()) {
+            LOG_ERROR("GameServer", "출력 이벤트 패킷 크기 초과 (PktID: " << pkt_id
+                << ", Gateway: " << route.gateway_id << ", 수신자: " << msg.target_handles_size() << ") - 전송 취소");
+            continue;
+        }
+        route.session->SendShared(packet);
+    }
+}
+
+// encode_strand_에서 실행: 이벤트별 메시지 조립 후 수신자 소속 Gateway별로 나눠 전송
+void GameOutputStage::Encode(const OutputBatch& batch) {
+    RefreshRoutes();
+
+    for (const OutputEvent& ev : batch.events) {
+        if (ev.handle_count == 0) continue;
+        const uint32_t* handles = batch.handles.data() + ev.handle_begin;
+
+        switch (ev.kind) {
+        case OutputEvent::Kind::MONSTER_MOVE:
+        case OutputEvent::Kind::PLAYER_MOVE:
+        case OutputEvent::Kind::PLAYER_TELEPORT: {
+            Protocol::GameGatewayMoveRes res;
+            if (ev.kind == OutputEvent::Kind::MONSTER_MOVE) {
+                res.set_account_id("MONSTER_" + std::to_string(ev.entity_id));
+            }
+            else {
+                res.set_account_id(ev.account.data, ev.account.len);
+                res.set_mover_handle(ev.mover_handle);
+            }
+            res.set_x(ev.x);
+            res.set_y(ev.y);
+            res.set_z(ev.z);
+            res.set_yaw(0.0f);
+            Route(Protocol::PKT_GAME_GATEWAY_MOVE_RES, res, handles, ev.handle_count);
+            break;
+        }
+        case OutputEvent::Kind::ATTACK_MONSTER:
+        case OutputEvent::Kind::ATTACK_PLAYER:
+        case OutputEvent::Kind::ATTACK_MISS: {
+            Protocol::GameGatewayAttackRes res;
+            res.set_attacker_uid(ev.entity_id);
+            if (ev.kind == OutputEvent::Kind::ATTACK_MONSTER) {
+                res.set_target_uid(ev.target_uid);
+                res.set_target_account_id("MONSTER_" + std::to_string(ev.target_uid));
+            }
+            else if (ev.kind == OutputEvent::Kind::ATTACK_PLAYER) {
+                res.set_target_uid(ev.target_uid);
+                res.set_target_account_id(ev.account.data, ev.account.len);
+            }
+            res.set_damage(ev.damage);
+            res.set_target_remain_hp(ev.remain_hp);
+            Route(Protocol::PKT_GAME_GATEWAY_ATTACK_RES, res, handles, ev.handle_count);
+            break;
+        }
+        case OutputEvent::Kind::CHAT: {
+            Protocol::GameGatewayChatRes res;
+            res.set_account_id(ev.account.data, ev.account.len);
+            res.set_msg(batch.text.data() + ev.text_begin, ev.text_len);
+            Route(Protocol::PKT_GAME_GATEWAY_CHAT_RES, res, handles, ev.handle_count);
+            break;
+        }
         }
     }
+
+    routes_.clear();    // 세션 참조 해제 (용량은 유지)
 }
 
 void StartAIThreadPool(int ai_thread_count) {
@@ -163,6 +297,20 @@ int main() {
         GameConstants::Map::SECTOR_SIZE
     );
 
+    // 맵별 AOI LOD 설정 (config.json 미지정 시 GameConstants 기본값)
+    {
+        auto& cfg = ConfigManager::GetInstance();
+        AoiLodConfig lod;
+        lod.near_radius  = cfg.GetAoiLodNearRadius();
+        lod.mid_radius   = cfg.GetAoiLodMidRadius();
+        lod.mid_interval = static_cast<uint32_t>(cfg.GetAoiLodMidInterval());
+        lod.far_interval = static_cast<uint32_t>(cfg.GetAoiLodFarInterval());
+        lod.settle_ms    = static_cast<uint32_t>(cfg.GetAoiLodSettleMs());
+        ctx.zone->SetLodConfig(lod);
+        LOG_INFO("System", "AOI LOD 설정: NEAR " << lod.near_radius << " / MID " << lod.mid_radius
+            << " (1/" << lod.mid_interval << ") / FAR (1/" << lod.far_interval << ") / 정지 보정 " << lod.settle_ms << "ms");
+    }
+
     GenerateDummyMapFile("dummy_map.bin");
     ctx.navMesh.LoadNavMeshFromFile("dummy_map.bin");
 
@@ -173,14 +321,16 @@ int main() {
     StartAIThreadPool(ai_thread_count);
 
     // Gateway -> Game 핸들러 등록
-    ctx.gatewayDispatcher.RegisterHandler(Protocol::PKT_GATEWAY_GAME_MOVE_REQ,   Handle_GatewayGameMoveReq);
-    ctx.gatewayDispatcher.RegisterHandler(Protocol::PKT_GATEWAY_GAME_LEAVE_REQ,  Handle_GatewayGameLeaveReq);
-    ctx.gatewayDispatcher.RegisterHandler(Protocol::PKT_GATEWAY_GAME_ATTACK_REQ, Handle_GatewayGameAttackReq);
-    ctx.gatewayDispatcher.RegisterHandler(Protocol::PKT_GATEWAY_GAME_CHAT_REQ,   Handle_GatewayGameChatReq);
+    //   이동/퇴장/공격은 타입 명령: 수신 I/O 스레드에서 디코딩/검증 후 game_strand_에는 구조체만 전달
+    ctx.gatewayDispatcher.RegisterCommand<MoveCommand, &Decode_GatewayGameMoveReq, &Handle_GatewayGameMoveReq>(Protocol::PKT_GATEWAY_GAME_MOVE_REQ);
+    ctx.gatewayDispatcher.RegisterCommand<LeaveCommand, &Decode_GatewayGameLeaveReq, &Handle_GatewayGameLeaveReq>(Protocol::PKT_GATEWAY_GAME_LEAVE_REQ);
+    ctx.gatewayDispatcher.RegisterCommand<AttackCommand, &Decode_GatewayGameAttackReq, &Handle_GatewayGameAttackReq>(Protocol::PKT_GATEWAY_GAME_ATTACK_REQ);
+    ctx.gatewayDispatcher.RegisterHandler<&Handle_GatewayGameChatReq>(Protocol::PKT_GATEWAY_GAME_CHAT_REQ);
+    ctx.gatewayDispatcher.RegisterHandler<&Handle_GatewayGameLaneHello>(Protocol::PKT_GATEWAY_GAME_LANE_HELLO);
 
     // World -> Game 핸들러 등록
-    ctx.worldDispatcher.RegisterHandler(Protocol::PKT_WORLD_GAME_MONSTER_BUFF,   Handle_WorldGameMonsterBuff);
-    ctx.worldDispatcher.RegisterHandler(Protocol::PKT_WORLD_GAME_TOKEN_NOTIFY,   Handle_WorldGameTokenNotify);
+    ctx.worldDispatcher.RegisterHandler<&Handle_WorldGameMonsterBuff>(Protocol::PKT_WORLD_GAME_MONSTER_BUFF);
+    ctx.worldDispatcher.RegisterHandler<&Handle_WorldGameTokenNotify>(Protocol::PKT_WORLD_GAME_TOKEN_NOTIFY);
 
     try {
         short game_port = ConfigManager::GetInstance().GetGameServerPort();
@@ -213,7 +363,12 @@ int main() {
                     LOG_FATAL("Watchdog", "5초간 처리된 패킷이 0개입니다! 데드락 발생 의심!!!");
                 }
                 else if (bot_count > 0) {
-                    LOG_INFO("Watchdog", "서버 정상 틱 동작 중 (5초간 처리량: " << (current_count - last_count) << " pkts)");
+                    LOG_INFO("Watchdog", "서버 정상 틱 동작 중 (5초간 처리량: " << (current_count - last_count) << " pkts"
+                        << ", write당 패킷 수: " << GatherWriteStats::GetPacketsPerWrite()
+                        << ", S2S 압축률: " << S2SCompression::Stats::GetRatio()
+                        << " (" << S2SCompression::Stats::GetCompressedFrames() << " frames)"
+                        << ", 송신 풀(사용/최고/용량): " << SendBufferPool::GetInstance().FormatStats()
+                        << ", 핸들러 상위3(ID:호출/평균): " << ctx.gatewayDispatcher.FormatTopStats(3) << ")");
                 }
                 last_count = current_count;
             }
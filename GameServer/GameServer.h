@@ -9,6 +9,7 @@
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <chrono>
 
 #pragma warning(push)
 #pragma warning(disable: 26495 26439 26451 26812 26815 26816 6385 6386 6001 6255 6387 6031 6258 26819 26498)
@@ -19,6 +20,7 @@
 #include "Zone/Zone.h"
 #include "Monster/Monster.h"
 #include "Pathfinder/Pathfinder.h"
+#include "Network/GameOutput.h"
 
 #include "../Common/DataManager/DataManager.h"
 #include "../Common/Define/GameConstants.h"
@@ -51,6 +53,16 @@ struct PlayerInfo {
     int atk = GameConstants::Player::DEFAULT_ATK;
     int def = GameConstants::Player::DEFAULT_DEF;
 
+    // Gateway가 발급한 세션 핸들 ([gatewayId 8비트][세대 4비트][슬롯 20비트])
+    // 팬아웃 응답의 target_handles에 그대로 실어 보냄 (0 = 미발급)
+    uint32_t session_handle = 0;
+
+    // 이동 순번 (AOI LOD 대역별 전송 주기 판정용, 이동마다 1 증가)
+    uint32_t move_seq = 0;
+
+    // 마지막 이동 시각 (LOD로 건너뛴 관찰자에게 정지 후 최종 위치를 보낼 시점 판정용)
+    std::chrono::steady_clock::time_point last_move_time;
+
     PlayerInfo() = default;
     PlayerInfo(const PlayerInfo&) = delete;
     PlayerInfo& operator=(const PlayerInfo&) = delete;
@@ -91,10 +103,28 @@ struct GameContext {
     // playerMap, monsterMap, uidToAccount 등 게임 상태는 이 strand에 의해 보호됨
     boost::asio::io_context::strand game_strand_;
 
+    //   game_strand_ 출력 이벤트 -> I/O 스레드 인코딩/전송 단계
+    // AI Tick, 몬스터 공격 콜백, 공격 핸들러의 Gateway 브로드캐스트는 여기로 Emit
+    GameOutputStage output_stage;
+
     //   playerMutex_, monsterMutex_ 제거 — game_strand_가 직렬화를 담당
     std::unordered_map<std::string, std::shared_ptr<PlayerInfo>> playerMap;
     std::unordered_map<uint64_t, std::string> uidToAccount;
 
+    //   AOI 결과(uid) -> 세션 핸들 조회용
+    // 변경 전: uid -> account_id 문자열을 찾아 repeated string으로 직렬화
+    // 변경 후: uid -> PlayerInfo를 찾아 session_handle(uint32)만 packed로 직렬화
+    std::unordered_map<uint64_t, std::shared_ptr<PlayerInfo>> uidToPlayer;
+
+    uint32_t FindSessionHandle(uint64_t uid) const {
+        auto it = uidToPlayer.find(uid);
+        if (it == uidToPlayer.end()) return 0;
+        return it->second->session_handle;
+    }
+
+    //   LOD로 최종 위치를 받지 못한 관찰자가 있는 이동자 uid (FlushSettledPlayerMoves에서 처리)
+    std::unordered_set<uint64_t> lodSettlePending;
+
     std::unordered_map<uint64_t, std::shared_ptr<Monster>> monsterMap;
     std::vector<std::shared_ptr<Monster>> monsters;
 
@@ -191,7 +221,8 @@ struct GameContext {
     //   game_strand_ 초기화 추가
     GameContext()
         : ai_work_guard(boost::asio::make_work_guard(ai_io_context))
-        , game_strand_(io_context) {
+        , game_strand_(io_context)
+        , output_stage(io_context) {
     }
 
     GameContext(const GameContext&) = delete;
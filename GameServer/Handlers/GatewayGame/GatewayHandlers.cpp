@@ -26,27 +26,135 @@
 //   -> 락 순서 규칙 자체가 불필요 (데드락 원천 제거)
 // ==========================================
 
-// [게이트웨이 -> 게임서버] 유저 이동 처리
-void Handle_GatewayGameMoveReq(std::shared_ptr<GatewaySession>& session, char* payload, uint16_t payloadSize) {
+// ==========================================
+//   I/O 스레드 디코더 (GatewaySession::ProcessFrames에서 호출)
+//
+// 변경 전: ParseFromArray + 좌표 보정이 핸들러 앞부분, 즉 game_strand_ 안에서 실행
+// 변경 후: 수신 I/O 스레드에서 명령 구조체로 변환 -> game_strand_는 게임 상태 갱신만 수행
+//   -> 여기서는 GameContext 상태(playerMap, zone 등)를 절대 만지지 않음
+// ==========================================
+static bool DecodeAccount(const std::string& account_id, AccountKey& out, const char* func) {
+    if (!out.Assign(account_id)) {
+        LOG_ERROR("GameServer", "잘못된 계정 ID 길이: " << func << " (len=" << account_id.size() << ")");
+        return false;
+    }
+    return true;
+}
 
-    auto req = std::make_shared<Protocol::GatewayGameMoveReq>();
+bool Decode_GatewayGameMoveReq(const char* payload, uint16_t payloadSize, MoveCommand& out) {
+    auto* req = PacketArena::Create<Protocol::GatewayGameMoveReq>();
     if (!req->ParseFromArray(payload, payloadSize)) {
         LOG_ERROR("GameServer", "ParseFromArray 실패: " << __func__ << " (payloadSize=" << payloadSize << ")");
-        return;
+        return false;
     }
+    if (!DecodeAccount(req->account_id(), out.account, __func__)) return false;
 
-    auto& ctx = GameContext::Get();
-
-    std::string acc_id = req->account_id();
     float new_x = req->x();
     float new_y = req->y();
 
+    // NaN/Inf는 클램프를 통과해 그리드/LOD 계산을 오염시키므로 보정 전에 거부
+    if (!std::isfinite(new_x) || !std::isfinite(new_y)) {
+        LOG_ERROR("GameServer", "비정상 좌표 거부: " << __func__ << " (x=" << new_x << ", y=" << new_y << ")");
+        return false;
+    }
+
     // 맵 이탈 방지
     if (new_x < 0.0f) new_x = 0.0f;
     if (new_y < 0.0f) new_y = 0.0f;
     if (new_x > GameConstants::Map::WIDTH) new_x = GameConstants::Map::WIDTH;
     if (new_y > GameConstants::Map::HEIGHT) new_y = GameConstants::Map::HEIGHT;
 
+    out.x = new_x;
+    out.y = new_y;
+    out.session_handle = req->session_handle();
+    return true;
+}
+
+bool Decode_GatewayGameLeaveReq(const char* payload, uint16_t payloadSize, LeaveCommand& out) {
+    auto* req = PacketArena::Create<Protocol::GatewayGameLeaveReq>();
+    if (!req->ParseFromArray(payload, payloadSize)) {
+        LOG_ERROR("GameServer", "ParseFromArray 실패: " << __func__ << " (payloadSize=" << payloadSize << ")");
+        return false;
+    }
+    return DecodeAccount(req->account_id(), out.account, __func__);
+}
+
+bool Decode_GatewayGameAttackReq(const char* payload, uint16_t payloadSize, AttackCommand& out) {
+    auto* req = PacketArena::Create<Protocol::GatewayGameAttackReq>();
+    if (!req->ParseFromArray(payload, payloadSize)) {
+        LOG_ERROR("GameServer", "ParseFromArray 실패: " << __func__ << " (payloadSize=" << payloadSize << ")");
+        return false;
+    }
+    if (!DecodeAccount(req->account_id(), out.account, __func__)) return false;
+
+    out.session_handle = req->session_handle();
+    return true;
+}
+
+// ==========================================
+//   EmitPlayerMove - 이동 출력 이벤트 기록 + 수신자 선택 (game_strand_ 전용)
+//
+// 메시지 조립/직렬화는 출력 인코딩 단계(I/O 스레드)에서 수행
+//   -> 귀환(PLAYER_TELEPORT) 등 같은 유저의 다른 이동 출력과 기록 순서대로 전송됨
+//
+// [AOI 거리 기반 갱신 주기(LOD)]
+// 변경 전: AOI 안의 앞쪽 MAX_AOI_BROADCAST명에게 매 이동마다 전송
+//   -> 거리와 무관하게 동일 빈도, 상한도 순회 순서로 잘려 나감
+//
+// 변경 후: 관찰자 거리 대역(NEAR/MID/FAR)별 주기로 이번 이동의 수신 여부 결정 (apply_lod)
+//   -> 본인은 항상 포함 (위치 보정, 우선순위 힌트)
+//   -> MAX_AOI_BROADCAST는 LOD를 통과한 관찰자 중 가까운 순으로 적용 (AoiRecipientSelector)
+//
+// 반환값: LOD 때문에 이번 위치를 받지 못한 관찰자가 있으면 true
+// ==========================================
+static bool EmitPlayerMove(const PlayerInfo& player, const AccountKey& account, bool apply_lod) {
+    auto& ctx = GameContext::Get();
+
+    OutputEvent& move_ev = ctx.output_stage.Emit(OutputEvent::Kind::PLAYER_MOVE);
+    move_ev.account = account;
+    move_ev.x = player.x;
+    move_ev.y = player.y;
+    move_ev.mover_handle = player.session_handle;   // Gateway 압축 이동 코덱의 엔티티 ID
+
+    const AoiLodConfig& lod = ctx.zone->GetLodConfig();
+    bool lod_skipped = false;
+
+    AoiPriorityHints hints;
+    hints.Add(player.uid);
+
+    // AOI 대상 세션 핸들 조회 (game_strand_ 보호, 뮤텍스 불필요)
+    AoiBroadcastSelector selector;
+    ctx.zone->SelectPlayersInAOI(player.x, player.y, selector, [&](uint64_t target_uid, AoiCandidate& out) {
+        auto it_target = ctx.uidToPlayer.find(target_uid);
+        if (it_target == ctx.uidToPlayer.end()) return false;
+        const PlayerInfo& target = *it_target->second;
+        if (target.session_handle == 0) return false;
+
+        float dx = target.x - player.x;
+        float dy = target.y - player.y;
+        float dist_sq = dx * dx + dy * dy;
+        if (apply_lod && !hints.Contains(target_uid) && !lod.ShouldSend(dist_sq, player.move_seq, target_uid)) {
+            lod_skipped = true;
+            return false;
+        }
+
+        out.handle = target.session_handle;
+        out.score = hints.Score(target_uid, dist_sq);
+        return true;
+    });
+    selector.ForEach([&](const AoiCandidate& c) { ctx.output_stage.AddRecipient(c.handle); });
+
+    return lod_skipped;
+}
+
+// [게이트웨이 -> 게임서버] 유저 이동 처리
+void Handle_GatewayGameMoveReq(std::shared_ptr<GatewaySession>& session, const MoveCommand& cmd) {
+    auto& ctx = GameContext::Get();
+
+    std::string acc_id = cmd.account.ToString();
+    float new_x = cmd.x;
+    float new_y = cmd.y;
+
     //   game_strand_ 보호 하에 직접 접근 (뮤텍스 불필요)
     auto it = ctx.playerMap.find(acc_id);
     std::shared_ptr<PlayerInfo> player_ptr;
@@ -64,6 +172,7 @@ void Handle_GatewayGameMoveReq(std::shared_ptr<GatewaySession>& session, char* p
 
         ctx.playerMap[acc_id] = player_ptr;
         ctx.uidToAccount[new_uid] = acc_id;
+        ctx.uidToPlayer[new_uid] = player_ptr;
 
         //   게이트웨이 소속 유저 등록 (장애 복구용)
         ctx.RegisterPlayerToGateway(session.get(), acc_id);
@@ -78,6 +187,9 @@ void Handle_GatewayGameMoveReq(std::shared_ptr<GatewaySession>& session, char* p
         RedisManager::GetInstance().SetPlayerOnline(acc_id, GameConstants::Player::DEFAULT_HP);
     }
 
+    // Gateway 재접속 시 핸들이 바뀔 수 있으므로 요청마다 갱신
+    if (cmd.session_handle != 0) player_ptr->session_handle = cmd.session_handle;
+
     // 좌표 갱신 + Zone 위치 업데이트 (game_strand_ 보호, 뮤텍스 불필요)
     float old_x = player_ptr->x;
     float old_y = player_ptr->y;
@@ -85,35 +197,59 @@ void Handle_GatewayGameMoveReq(std::shared_ptr<GatewaySession>& session, char* p
     player_ptr->y = new_y;
     ctx.zone->UpdatePosition(player_ptr->uid, old_x, old_y, new_x, new_y);
 
-    auto aoi_uids = ctx.zone->GetPlayersInAOI(new_x, new_y);
-    Protocol::GameGatewayMoveRes s2s_res;
-    s2s_res.set_account_id(acc_id);
-    s2s_res.set_x(new_x);
-    s2s_res.set_y(new_y);
-
-    // AOI 대상 account_id 조회 (game_strand_ 보호, 뮤텍스 불필요)
-    int broadcast_limit = 0;
-    for (uint64_t target_uid : aoi_uids) {
-        if (broadcast_limit++ >= GameConstants::Network::MAX_AOI_BROADCAST) break;
-        auto uid_it = ctx.uidToAccount.find(target_uid);
-        if (uid_it != ctx.uidToAccount.end()) {
-            s2s_res.add_target_account_ids(uid_it->second);
-        }
+    player_ptr->last_move_time = std::chrono::steady_clock::now();
+    ++player_ptr->move_seq;
+
+    // 건너뛴 관찰자가 있으면 정지 후 최종 위치 전송 대상으로 등록 (다음 이동에서 모두 받으면 해제)
+    if (EmitPlayerMove(*player_ptr, cmd.account, true)) {
+        ctx.lodSettlePending.insert(player_ptr->uid);
+    }
+    else {
+        ctx.lodSettlePending.erase(player_ptr->uid);
     }
-    
-    session->Send(Protocol::PKT_GAME_GATEWAY_MOVE_RES, s2s_res);
 }
 
-// [게이트웨이 -> 게임서버] 유저 퇴장 처리 핸들러
-void Handle_GatewayGameLeaveReq(std::shared_ptr<GatewaySession>& session, char* payload, uint16_t payloadSize) {
-    auto req = std::make_shared<Protocol::GatewayGameLeaveReq>();
-    if (!req->ParseFromArray(payload, payloadSize)) {
-        LOG_ERROR("GameServer", "ParseFromArray 실패: " << __func__ << " (payloadSize=" << payloadSize << ")");
-        return;
+// ==========================================
+//   LOD 정지 보정 - 멈춘 이동자의 최종 위치를 AOI 전체에 1회 전송
+//
+// MID/FAR 관찰자는 move_seq 주기에 걸린 이동만 받으므로, 이동자가 주기 사이에서
+// 멈추면 다음 이동이 없어 옛 위치가 계속 남음
+//   -> 마지막 이동 후 settle_ms가 지나도록 추가 이동이 없으면 LOD 없이 재전송
+//   -> AI Tick(game_strand_) 주기로 호출, 대기 목록은 건너뛴 관찰자가 있던 이동자만 보관
+// ==========================================
+void FlushSettledPlayerMoves() {
+    auto& ctx = GameContext::Get();
+    if (ctx.lodSettlePending.empty()) return;
+
+    auto now = std::chrono::steady_clock::now();
+    auto settle = std::chrono::milliseconds(ctx.zone->GetLodConfig().settle_ms);
+
+    for (auto it = ctx.lodSettlePending.begin(); it != ctx.lodSettlePending.end();) {
+        auto it_player = ctx.uidToPlayer.find(*it);
+        if (it_player == ctx.uidToPlayer.end()) {
+            it = ctx.lodSettlePending.erase(it);
+            continue;
+        }
+
+        const PlayerInfo& player = *it_player->second;
+        if (now - player.last_move_time < settle) {
+            ++it;
+            continue;
+        }
+
+        AccountKey account;
+        auto it_acc = ctx.uidToAccount.find(*it);
+        if (it_acc != ctx.uidToAccount.end() && account.Assign(it_acc->second)) {
+            EmitPlayerMove(player, account, false);
+        }
+        it = ctx.lodSettlePending.erase(it);
     }
+}
 
+// [게이트웨이 -> 게임서버] 유저 퇴장 처리 핸들러
+void Handle_GatewayGameLeaveReq(std::shared_ptr<GatewaySession>& session, const LeaveCommand& cmd) {
     auto& ctx = GameContext::Get();
-    std::string acc_id = req->account_id();
+    std::string acc_id = cmd.account.ToString();
 
     //   game_strand_ 보호 하에 직접 접근 (뮤텍스 불필요)
     auto it = ctx.playerMap.find(acc_id);
@@ -123,6 +259,8 @@ void Handle_GatewayGameLeaveReq(std::shared_ptr<GatewaySession>& session, char*
         float last_y = it->second->y;
 
         ctx.uidToAccount.erase(uid);
+        ctx.uidToPlayer.erase(uid);
+        ctx.lodSettlePending.erase(uid);
         ctx.playerMap.erase(it);
 
         //   게이트웨이 소속에서 제거
@@ -140,16 +278,9 @@ void Handle_GatewayGameLeaveReq(std::shared_ptr<GatewaySession>& session, char*
 }
 
 // [게이트웨이 -> 게임서버] 유저의 공격 요청 처리
-void Handle_GatewayGameAttackReq(std::shared_ptr<GatewaySession>& session, char* payload, uint16_t size) {
-
-    auto req = std::make_shared<Protocol::GatewayGameAttackReq>();
-    if (!req->ParseFromArray(payload, size)) {
-        LOG_ERROR("GameServer", "ParseFromArray 실패: " << __func__ << " (payloadSize=" << size << ")");
-        return;
-    }
-
+void Handle_GatewayGameAttackReq(std::shared_ptr<GatewaySession>& session, const AttackCommand& cmd) {
     auto& ctx = GameContext::Get();
-    std::string account_id = req->account_id();
+    std::string account_id = cmd.account.ToString();
 
 #ifdef  DEF_STRESS_TEST_DEADLOCK_WATCHDOG
     if (account_id.find("BOT_STRESS") != std::string::npos) {
@@ -161,6 +292,7 @@ void Handle_GatewayGameAttackReq(std::shared_ptr<GatewaySession>& session, char*
     auto it_player = ctx.playerMap.find(account_id);
     if (it_player == ctx.playerMap.end()) return;
     auto& player_ptr = it_player->second;
+    if (cmd.session_handle != 0) player_ptr->session_handle = cmd.session_handle;
 
     float p_x = player_ptr->x;
     float p_y = player_ptr->y;
@@ -192,11 +324,9 @@ void Handle_GatewayGameAttackReq(std::shared_ptr<GatewaySession>& session, char*
 
     // 사거리 내에 몬스터가 없을 경우
     if (!target_monster) {
-        Protocol::GameGatewayAttackRes fail_res;
-        fail_res.set_attacker_uid(p_uid);
-        fail_res.set_damage(0);
-        fail_res.add_target_account_ids(account_id);
-        ctx.BroadcastToGateways(Protocol::PKT_GAME_GATEWAY_ATTACK_RES, fail_res);
+        OutputEvent& miss_ev = ctx.output_stage.Emit(OutputEvent::Kind::ATTACK_MISS);
+        miss_ev.entity_id = p_uid;
+        ctx.output_stage.AddRecipient(player_ptr->session_handle);
         return;
     }
 
@@ -209,24 +339,29 @@ void Handle_GatewayGameAttackReq(std::shared_ptr<GatewaySession>& session, char*
     LOG_INFO("Combat", "유저(" << account_id << ")가 몬스터(ID:"
         << target_monster->GetId() << ") 공격! 데미지: " << damage);
 
-    Protocol::GameGatewayAttackRes s2s_res;
-    s2s_res.set_attacker_uid(p_uid);
-    s2s_res.set_target_uid(target_monster->GetId());
-    s2s_res.set_target_account_id("MONSTER_" + std::to_string(target_monster->GetId()));
-    s2s_res.set_damage(damage);
-    s2s_res.set_target_remain_hp(remain_hp);
-
-    auto aoi_uids = ctx.zone->GetPlayersInAOI(p_x, p_y);
-    int broadcast_limit = 0;
-    for (uint64_t uid : aoi_uids) {
-        if (broadcast_limit++ >= GameConstants::Network::MAX_AOI_BROADCAST) break;
-        auto target_acc = ctx.uidToAccount.find(uid);
-        if (target_acc != ctx.uidToAccount.end()) {
-            s2s_res.add_target_account_ids(target_acc->second);
-        }
-    }
-
-    ctx.BroadcastToGateways(Protocol::PKT_GAME_GATEWAY_ATTACK_RES, s2s_res);
+    //   메시지 조립/직렬화는 출력 인코딩 단계(I/O 스레드)에서 수행
+    OutputEvent& attack_ev = ctx.output_stage.Emit(OutputEvent::Kind::ATTACK_MONSTER);
+    attack_ev.entity_id = p_uid;
+    attack_ev.target_uid = target_monster->GetId();
+    attack_ev.damage = damage;
+    attack_ev.remain_hp = remain_hp;
+
+    // 팬아웃 상한 안에서 공격자 본인 + 가까운 관찰자 순으로 선택
+    AoiPriorityHints hints;
+    hints.Add(p_uid);
+
+    AoiBroadcastSelector selector;
+    ctx.zone->SelectPlayersInAOI(p_x, p_y, selector, [&](uint64_t uid, AoiCandidate& out) {
+        auto it_target = ctx.uidToPlayer.find(uid);
+        if (it_target == ctx.uidToPlayer.end() || it_target->second->session_handle == 0) return false;
+
+        float dx = it_target->second->x - p_x;
+        float dy = it_target->second->y - p_y;
+        out.handle = it_target->second->session_handle;
+        out.score = hints.Score(uid, dx * dx + dy * dy);
+        return true;
+    });
+    selector.ForEach([&](const AoiCandidate& c) { ctx.output_stage.AddRecipient(c.handle); });
 
     if (remain_hp <= 0) {
         LOG_INFO("System", "몬스터(ID:" << target_monster->GetId() << ")가 쓰러졌습니다!");
@@ -238,7 +373,7 @@ void Handle_GatewayGameAttackReq(std::shared_ptr<GatewaySession>& session, char*
 //   채팅 AOI 처리 핸들러
 // ==========================================
 void Handle_GatewayGameChatReq(std::shared_ptr<GatewaySession>& session, char* payload, uint16_t payloadSize) {
-    Protocol::GatewayGameChatReq req;
+    auto& req = *PacketArena::Create<Protocol::GatewayGameChatReq>();
     if (!req.ParseFromArray(payload, payloadSize)) {
         LOG_ERROR("GameServer", "ParseFromArray 실패: " << __func__ << " (payloadSize=" << payloadSize << ")");
         return;
@@ -247,27 +382,84 @@ void Handle_GatewayGameChatReq(std::shared_ptr<GatewaySession>& session, char* p
     auto& ctx = GameContext::Get();
     std::string acc_id = req.account_id();
 
+    AccountKey account;
+    if (!account.Assign(acc_id)) {
+        LOG_ERROR("GameServer", "잘못된 계정 ID 길이: " << __func__ << " (len=" << acc_id.size() << ")");
+        return;
+    }
+
     //   game_strand_ 보호 하에 직접 접근 (뮤텍스 불필요)
     auto it = ctx.playerMap.find(acc_id);
     if (it == ctx.playerMap.end()) {
         LOG_WARN("GameServer", "채팅 발신자가 playerMap에 없음: " << acc_id);
         return;
     }
+    if (req.session_handle() != 0) it->second->session_handle = req.session_handle();
     float p_x = it->second->x;
     float p_y = it->second->y;
 
     auto aoi_uids = ctx.zone->GetPlayersInAOI(p_x, p_y);
 
-    Protocol::GameGatewayChatRes s2s_res;
-    s2s_res.set_account_id(acc_id);
-    s2s_res.set_msg(req.msg());
+    // 수신자 소속 Gateway별 분배와 직렬화는 출력 인코딩 단계에서 수행
+    //   -> 요청 레인의 Gateway는 자기가 발급한 핸들만 찾을 수 있으므로 직접 전송하면 다른 Gateway 유저가 누락됨
+    OutputEvent& chat_ev = ctx.output_stage.Emit(OutputEvent::Kind::CHAT);
+    chat_ev.account = account;
+    ctx.output_stage.SetText(req.msg());
 
     for (uint64_t uid : aoi_uids) {
-        auto uid_it = ctx.uidToAccount.find(uid);
-        if (uid_it != ctx.uidToAccount.end()) {
-            s2s_res.add_target_account_ids(uid_it->second);
+        ctx.output_stage.AddRecipient(ctx.FindSessionHandle(uid));
+    }
+}
+
+// ==========================================
+//   S2S 레인 식별 핸들러
+//
+// Gateway는 레인 N개를 맺고 유저를 account_id 해시로 레인에 고정 배정합니다.
+// 유저별 요청/응답은 해당 레인으로 오가며, 특정 요청에 묶이지 않은
+// 브로드캐스트(BroadcastToGateways)는 대표 레인(lane_index 0)으로만 보냅니다.
+//
+// gateway_id는 세션 핸들 상위 비트이자 출력 단계의 라우팅 키이므로 Gateway 프로세스마다 고유해야 함
+//   -> 이미 살아 있는 다른 세션이 같은 gateway_id의 대표 레인이면 새 대표 레인을 거부하고 연결 종료
+//      (같은 ID의 경로가 2개면 핸들 몫이 두 Gateway에 모두 전달되어 다른 유저에게 잘못 배달됨)
+// ==========================================
+void Handle_GatewayGameLaneHello(std::shared_ptr<GatewaySession>& session, char* payload, uint16_t payloadSize) {
+    auto& hello = *PacketArena::Create<Protocol::GatewayGameLaneHello>();
+    if (!hello.ParseFromArray(payload, payloadSize)) {
+        LOG_ERROR("GameServer", "ParseFromArray 실패: " << __func__ << " (payloadSize=" << payloadSize << ")");
+        return;
+    }
+
+    if (hello.lane_index() == 0) {
+        auto& ctx = GameContext::Get();
+        bool duplicate = false;
+        {
+            UTILITY::LockGuard lock(ctx.gatewaySessionMutex);
+            for (auto& other : ctx.gatewaySessions) {
+                if (other && other != session && other->IsPrimaryLane() && other->GetGatewayId() == hello.gateway_id()) {
+                    duplicate = true;
+                    break;
+                }
+            }
+        }
+        if (duplicate) {
+            LOG_ERROR("GameServer", "Gateway ID 중복! (ID:" << hello.gateway_id()
+                << ") 이미 연결된 다른 Gateway가 사용 중인 ID입니다. config.json의 gateway_id를 Gateway마다 다르게 설정하세요. 연결 종료.");
+            session->Close();
+            return;
         }
     }
 
-    session->Send(Protocol::PKT_GAME_GATEWAY_CHAT_RES, s2s_res);
+    session->SetLaneInfo(hello.gateway_id(), hello.lane_index());
+
+    // 양쪽 모두 지원하는 압축 코덱만 사용 (Ack보다 먼저 설정해도 Gateway는 이미 복원 가능)
+    uint32_t flags = hello.compression_flags() & S2SCompression::SupportedFlags();
+    session->SetCompressionFlags(flags);
+
+    Protocol::GameGatewayLaneHelloAck ack;
+    ack.set_compression_flags(flags);
+    session->Send(Protocol::PKT_GAME_GATEWAY_LANE_HELLO_ACK, ack);
+
+    LOG_INFO("GameServer", "Gateway(ID:" << hello.gateway_id() << ") S2S 레인 연결 ("
+        << hello.lane_index() << "/" << hello.lane_count() << ", 압축: "
+        << ((flags & S2SCompression::FLAG_LZ4) ? "LZ4" : "OFF") << ")");
 }
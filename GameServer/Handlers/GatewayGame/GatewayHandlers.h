@@ -2,11 +2,48 @@
 #include <memory>
 #include <cstdint>
 
+#include "../../Network/GameOutput.h"     // AccountKey
+
 class GatewaySession;
 
-void Handle_GatewayGameMoveReq(std::shared_ptr<GatewaySession>& session, char* payload, uint16_t payloadSize);
-void Handle_GatewayGameLeaveReq(std::shared_ptr<GatewaySession>& session, char* payload, uint16_t payloadSize);
-void Handle_GatewayGameAttackReq(std::shared_ptr<GatewaySession>& session, char* payload, uint16_t size);
+// ==========================================
+//   Gateway -> Game 타입 명령 (I/O 스레드 디코딩 결과)
+//
+// GatewaySession 수신 I/O 스레드에서 protobuf를 풀고 검증한 평범한 구조체
+// game_strand_에는 이 구조체 바이트만 전달됨 (PacketDispatcher::RegisterCommand)
+//   -> trivially copyable 유지: 문자열은 고정 길이 AccountKey로 보관
+// ==========================================
+struct MoveCommand {
+    AccountKey account;
+    float x;                    // 맵 범위로 보정된 좌표
+    float y;
+    uint32_t session_handle;
+};
+
+struct LeaveCommand {
+    AccountKey account;
+};
+
+struct AttackCommand {
+    AccountKey account;
+    uint32_t session_handle;
+};
+
+// I/O 스레드 디코더 (실패 시 false, 프레임 폐기)
+bool Decode_GatewayGameMoveReq(const char* payload, uint16_t payloadSize, MoveCommand& out);
+bool Decode_GatewayGameLeaveReq(const char* payload, uint16_t payloadSize, LeaveCommand& out);
+bool Decode_GatewayGameAttackReq(const char* payload, uint16_t payloadSize, AttackCommand& out);
+
+// game_strand_ 실행부
+void Handle_GatewayGameMoveReq(std::shared_ptr<GatewaySession>& session, const MoveCommand& cmd);
+void Handle_GatewayGameLeaveReq(std::shared_ptr<GatewaySession>& session, const LeaveCommand& cmd);
+void Handle_GatewayGameAttackReq(std::shared_ptr<GatewaySession>& session, const AttackCommand& cmd);
+
+//   LOD로 건너뛴 관찰자에게 정지한 이동자의 최종 위치 전송 (AI Tick, game_strand_에서 호출)
+void FlushSettledPlayerMoves();
 
 //   채팅 AOI 처리: Gateway로부터 채팅을 받아 AOI 대상을 계산하여 반환
 void Handle_GatewayGameChatReq(std::shared_ptr<GatewaySession>& session, char* payload, uint16_t payloadSize);
+
+//   S2S 레인 식별: Gateway 레인 연결 직후 소속 Gateway/레인 번호 등록
+void Handle_GatewayGameLaneHello(std::shared_ptr<GatewaySession>& session, char* payload, uint16_t payloadSize);
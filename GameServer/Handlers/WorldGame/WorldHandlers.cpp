@@ -9,7 +9,7 @@
 
 //   game_strand_ 기반으로 동작하므로 뮤텍스 불필요
 void Handle_WorldGameMonsterBuff(std::shared_ptr<WorldConnection>& session, char* payload, uint16_t payloadSize) {
-    auto req = std::make_shared<Protocol::WorldGameMonsterBuffReq>();
+    auto* req = PacketArena::Create<Protocol::WorldGameMonsterBuffReq>();
 
     if (!req->ParseFromArray(payload, payloadSize)) {
         LOG_ERROR("GameServer", "ParseFromArray 실패: WorldGameMonsterBuffReq (payloadSize=" << payloadSize << ")");
@@ -48,7 +48,7 @@ void Handle_WorldGameMonsterBuff(std::shared_ptr<WorldConnection>& session, char
 // GatewayServer는 이 토큰을 pending_tokens에 저장하여 클라이언트 접속 시 검증합니다.
 // ==========================================
 void Handle_WorldGameTokenNotify(std::shared_ptr<WorldConnection>& session, char* payload, uint16_t payloadSize) {
-    Protocol::TokenNotify notify;
+    auto& notify = *PacketArena::Create<Protocol::TokenNotify>();
     if (!notify.ParseFromArray(payload, payloadSize)) {
         LOG_ERROR("GameServer", "ParseFromArray 실패: TokenNotify (payloadSize=" << payloadSize << ")");
         return;
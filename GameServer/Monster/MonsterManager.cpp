@@ -10,6 +10,7 @@
 #pragma warning(pop)
 
 #include "../GameServer.h"
+#include "../Handlers/GatewayGame/GatewayHandlers.h"
 #include "../../Common/Redis/RedisManager.h"
 #include "../../Common/Define/GameConstants.h"
 #include "../../Common/Utils/Logger.h"
@@ -63,24 +64,20 @@ void InitMonsters() {
 
             RedisManager::GetInstance().UpdatePlayerHp(acc_id_str, remain_hp);
 
-            Protocol::GameGatewayAttackRes s2s_res;
-            s2s_res.set_attacker_uid(attacker_uid);
-            s2s_res.set_target_uid(target_uid);
-            s2s_res.set_target_account_id(acc_id_str);
-            s2s_res.set_damage(damage);
-            s2s_res.set_target_remain_hp(remain_hp);
+            //   메시지 조립/직렬화는 출력 인코딩 단계(I/O 스레드)에서 수행
+            auto& output = ctx_inner.output_stage;
+            OutputEvent& attack_ev = output.Emit(OutputEvent::Kind::ATTACK_PLAYER);
+            attack_ev.entity_id = attacker_uid;
+            attack_ev.target_uid = target_uid;
+            attack_ev.account.Assign(acc_id_str);
+            attack_ev.damage = damage;
+            attack_ev.remain_hp = remain_hp;
 
             auto aoi_uids = ctx_inner.zone->GetPlayersInAOI(p_x, p_y);
-
             for (uint64_t aoi_uid : aoi_uids) {
-                auto target_acc = ctx_inner.uidToAccount.find(aoi_uid);
-                if (target_acc != ctx_inner.uidToAccount.end()) {
-                    s2s_res.add_target_account_ids(target_acc->second);
-                }
+                output.AddRecipient(ctx_inner.FindSessionHandle(aoi_uid));
             }
 
-            ctx_inner.BroadcastToGateways(Protocol::PKT_GAME_GATEWAY_ATTACK_RES, s2s_res);
-
             LOG_INFO("Combat", "몬스터(" << attacker_uid << ")가 유저(" << acc_id_str
                 << ")를 공격! 데미지: " << damage << ", 남은 체력: " << remain_hp);
 
@@ -101,15 +98,12 @@ void InitMonsters() {
                 ctx_inner.zone->UpdatePosition(target_uid, old_x, old_y,
                     GameConstants::Player::SPAWN_X, GameConstants::Player::SPAWN_Y);
 
-                Protocol::GameGatewayMoveRes teleport_res;
-                teleport_res.set_account_id(acc_id_str);
-                teleport_res.set_x(GameConstants::Player::SPAWN_X);
-                teleport_res.set_y(GameConstants::Player::SPAWN_Y);
-                teleport_res.set_z(0.0f);
-                teleport_res.set_yaw(0.0f);
-                teleport_res.add_target_account_ids(acc_id_str);
-
-                ctx_inner.BroadcastToGateways(Protocol::PKT_GAME_GATEWAY_MOVE_RES, teleport_res);
+                OutputEvent& teleport_ev = output.Emit(OutputEvent::Kind::PLAYER_TELEPORT);
+                teleport_ev.account.Assign(acc_id_str);
+                teleport_ev.x = GameConstants::Player::SPAWN_X;
+                teleport_ev.y = GameConstants::Player::SPAWN_Y;
+                teleport_ev.mover_handle = player_ptr->session_handle;
+                output.AddRecipient(player_ptr->session_handle);
                 return;
             }
         });
@@ -155,21 +149,17 @@ void ProcessDeadMonster(std::shared_ptr<Monster>& mon, float delta_time) {
     auto aoi_uids = ctx.zone->GetPlayersInAOI(mon->GetPosition().x, mon->GetPosition().y);
     if (aoi_uids.empty()) return;
 
-    Protocol::GameGatewayMoveRes s2s_res;
-    s2s_res.set_account_id("MONSTER_" + std::to_string(mon->GetId()));
-    s2s_res.set_x(mon->GetPosition().x);
-    s2s_res.set_y(mon->GetPosition().y);
-    s2s_res.set_z(mon->GetPosition().z);
-    s2s_res.set_yaw(0.0f);
+    //   POD 이벤트만 기록, "MONSTER_<id>" 생성과 직렬화는 출력 인코딩 단계에서
+    OutputEvent& ev = ctx.output_stage.Emit(OutputEvent::Kind::MONSTER_MOVE);
+    ev.entity_id = mon->GetId();
+    ev.x = mon->GetPosition().x;
+    ev.y = mon->GetPosition().y;
+    ev.z = mon->GetPosition().z;
 
     //   game_strand_ 보호 — 뮤텍스 불필요
     for (uint64_t target_uid : aoi_uids) {
-        auto it = ctx.uidToAccount.find(target_uid);
-        if (it != ctx.uidToAccount.end()) {
-            s2s_res.add_target_account_ids(it->second);
-        }
+        ctx.output_stage.AddRecipient(ctx.FindSessionHandle(target_uid));
     }
-    ctx.BroadcastToGateways(Protocol::PKT_GAME_GATEWAY_MOVE_RES, s2s_res);
 }
 
 // [분리] IDLE 상태: 주변 유저 탐색하여 어그로 발동
@@ -263,21 +253,17 @@ void SyncMonsterPosition(std::shared_ptr<Monster>& mon, float old_x, float old_y
 
     if (aoi_uids.empty()) return;
 
-    Protocol::GameGatewayMoveRes s2s_res;
-    s2s_res.set_account_id("MONSTER_" + std::to_string(mon->GetId()));
-    s2s_res.set_x(new_x);
-    s2s_res.set_y(new_y);
-    s2s_res.set_z(mon->GetPosition().z);
-    s2s_res.set_yaw(0.0f);
+    //   POD 이벤트만 기록, "MONSTER_<id>" 생성과 직렬화는 출력 인코딩 단계에서
+    OutputEvent& ev = ctx.output_stage.Emit(OutputEvent::Kind::MONSTER_MOVE);
+    ev.entity_id = mon->GetId();
+    ev.x = new_x;
+    ev.y = new_y;
+    ev.z = mon->GetPosition().z;
 
     //   game_strand_ 보호 — 뮤텍스 불필요
     for (uint64_t target_uid : aoi_uids) {
-        auto it = ctx.uidToAccount.find(target_uid);
-        if (it != ctx.uidToAccount.end()) {
-            s2s_res.add_target_account_ids(it->second);
-        }
+        ctx.output_stage.AddRecipient(ctx.FindSessionHandle(target_uid));
     }
-    ctx.BroadcastToGateways(Protocol::PKT_GAME_GATEWAY_MOVE_RES, s2s_res);
 }
 
 // ==========================================
@@ -340,6 +326,9 @@ void ScheduleNextAITick() {
                 SyncMonsterPosition(mon, old_x, old_y, delta_time);
             }
 
+            // LOD로 건너뛴 관찰자에게 정지한 유저의 최종 위치 전송
+            FlushSettledPlayerMoves();
+
             ScheduleNextAITick();
         })
     );
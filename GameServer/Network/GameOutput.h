@@ -0,0 +1,203 @@
+﻿#pragma once
+#include <boost/asio.hpp>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "../../Common/Define/SecurityConstants.h"
+#include "../../Common/Define/GameConstants.h"
+#include "../../Common/Utils/Lock.h"
+
+class GatewaySession;
+
+// ==========================================
+//   AccountKey - 고정 길이 계정 ID (바이트 복사 가능한 구조체에 문자열을 싣는 용도)
+//
+// I/O 스레드 디코딩 명령(GatewayHandlers.h)과 출력 이벤트(OutputEvent)가 공용으로 사용
+// ==========================================
+struct AccountKey {
+    uint8_t len = 0;
+    char data[SecurityConstants::Input::MAX_ACCOUNT_ID_LENGTH];
+
+    // 빈 값이나 최대 길이를 넘는 계정 ID는 거부
+    bool Assign(const std::string& id) {
+        if (id.empty() || id.size() > sizeof(data)) return false;
+        len = static_cast<uint8_t>(id.size());
+        std::memcpy(data, id.data(), id.size());
+        return true;
+    }
+
+    std::string ToString() const { return std::string(data, len); }
+};
+
+// ==========================================
+//   OutputEvent - game_strand_가 내보내는 출력 이벤트 (POD)
+//
+// protobuf 메시지 대신 엔티티/좌표/수치와 수신자 핸들 범위만 기록
+// 실제 GameGatewayMoveRes/AttackRes/ChatRes 조립과 직렬화는 인코딩 단계에서 수행
+// ==========================================
+struct OutputEvent {
+    enum class Kind : uint8_t {
+        MONSTER_MOVE,       // MoveRes: account_id = "MONSTER_<entity_id>" (스폰/리스폰/위치 동기화)
+        PLAYER_MOVE,        // MoveRes: account_id = account, mover_handle 포함 (이동 요청)
+        PLAYER_TELEPORT,    // MoveRes: account_id = account, mover_handle 포함 (사망 후 마을 복귀)
+        ATTACK_MONSTER,     // AttackRes: 유저(entity_id) -> 몬스터(target_uid)
+        ATTACK_PLAYER,      // AttackRes: 몬스터(entity_id) -> 유저(target_uid, account)
+        ATTACK_MISS,        // AttackRes: 사거리 내 대상 없음 (damage 0)
+        CHAT,               // ChatRes: account_id = account, msg = OutputBatch::text 구간
+    };
+
+    Kind kind = Kind::MONSTER_MOVE;
+    AccountKey account;
+    uint64_t entity_id = 0;
+    uint64_t target_uid = 0;
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+    int32_t damage = 0;
+    int32_t remain_hp = 0;
+    uint32_t mover_handle = 0;
+
+    // OutputBatch::handles 안의 수신자 세션 핸들 구간
+    uint32_t handle_begin = 0;
+    uint32_t handle_count = 0;
+
+    // OutputBatch::text 안의 가변 길이 문자열 구간 (CHAT)
+    uint32_t text_begin = 0;
+    uint32_t text_len = 0;
+};
+
+struct OutputBatch {
+    std::vector<OutputEvent> events;
+    std::vector<uint32_t> handles;
+    std::string text;
+
+    bool Empty() const { return events.empty(); }
+    void Clear() {
+        events.clear();     // 용량 유지 (다음 배치 재사용)
+        handles.clear();
+        text.clear();
+    }
+};
+
+// ==========================================
+//   GameOutputStage - 출력 인코딩 단계 (game_strand_ 밖에서 직렬화/전송)
+//
+// [변경 전 문제]
+//   AI Tick(SyncMonsterPosition, ProcessDeadMonster), 몬스터 공격 콜백, 이동/공격 핸들러가
+//   game_strand_ 안에서 protobuf 조립 + "MONSTER_<id>" 문자열 생성 + 직렬화 후
+//   BroadcastToGateways에서 gatewaySessionMutex까지 잡음
+//   -> 서버 전체 처리량을 묶는 단일 직렬 구간이 직렬화 비용과 락 대기를 떠안음
+//   -> 이동 응답만 요청 레인으로 따로 나가면 같은 유저의 귀환(대표 레인)과 순서가 뒤바뀔 수 있음
+//
+// [변경 후]
+//   game_strand_는 Emit()/AddRecipient()로 POD 이벤트와 수신자 핸들만 배치에 기록
+//   -> 첫 이벤트에서 game_strand_에 플러시를 예약, 현재 strand 작업이 끝나면 배치째로
+//      encode_strand_(io_context I/O 스레드)에 넘김
+//   -> encode_strand_에서 이벤트별 메시지 조립/직렬화 후 Gateway 세션들에 전송
+//   -> encode_strand_는 직렬이므로 이벤트 순서는 game_strand_ 기록 순서 그대로 유지
+//
+// [Gateway별 라우팅]
+// 변경 전: 수신자 목록 전체를 담은 메시지 1개를 모든 Gateway 대표 레인에 전송
+//   -> Gateway N개면 S2S 팬아웃 트래픽 N배, 각 Gateway는 자기 것이 아닌 핸들까지 모두 조회
+// 변경 후: 수신자 핸들을 발급 Gateway(핸들 상위 비트)별로 나눠 해당 Gateway에 자기 몫만 전송
+//   -> 핸들 자체가 소속 Gateway를 담고 있으므로 game_strand_ 상태(gatewayPlayerMap_) 없이
+//      인코딩 단계에서 바로 분배 가능
+//   -> 배치마다 gatewaySessionMutex를 1회 잡아 Gateway ID -> 대표 레인 경로표만 복사
+//   -> 경로가 없는 Gateway(연결 끊김/Hello 전)의 몫은 전송하지 않음
+//
+// [사용 예] (game_strand_ 안에서만)
+//   OutputEvent& ev = ctx.output_stage.Emit(OutputEvent::Kind::MONSTER_MOVE);
+//   ev.entity_id = mon_id; ev.x = x; ev.y = y;
+//   for (uint64_t uid : aoi_uids) ctx.output_stage.AddRecipient(ctx.FindSessionHandle(uid));
+//   -> 반환된 참조는 다음 Emit() 전까지만 유효
+// ==========================================
+class GameOutputStage {
+private:
+    boost::asio::io_context::strand encode_strand_;
+
+    // game_strand_ 전용
+    std::shared_ptr<OutputBatch> pending_;
+    bool flush_scheduled_ = false;
+
+    // encode_strand_ 전용: Gateway ID -> 대표 레인 경로표 (배치마다 갱신, 용량 재사용)
+    struct GatewayRoute {
+        uint32_t gateway_id;
+        std::shared_ptr<GatewaySession> session;
+    };
+    std::vector<GatewayRoute> routes_;
+
+    // 배치 재사용 목록 (game_strand_에서 대여, encode_strand_에서 반납)
+    std::vector<OutputBatch*> free_batches_;
+    UTILITY::Lock free_mutex_;
+
+    std::shared_ptr<OutputBatch> AcquireBatch() {
+        OutputBatch* batch = nullptr;
+        {
+            UTILITY::LockGuard lock(free_mutex_);
+            if (!free_batches_.empty()) {
+                batch = free_batches_.back();
+                free_batches_.pop_back();
+            }
+        }
+        if (!batch) batch = new OutputBatch();
+        return std::shared_ptr<OutputBatch>(batch, [this](OutputBatch* b) {
+            b->Clear();
+            UTILITY::LockGuard lock(free_mutex_);
+            free_batches_.push_back(b);
+        });
+    }
+
+    static uint32_t GatewayOf(uint32_t handle) {
+        return handle >> GameConstants::Network::SESSION_HANDLE_INDEX_BITS;
+    }
+
+    // 정의는 GameServer.cpp (GameContext/GatewaySession 의존)
+    void ScheduleFlush();
+    void Encode(const OutputBatch& batch);
+    void RefreshRoutes();
+
+    // msg의 target_handles를 Gateway별로 채워 각 Gateway에 자기 몫만 전송
+    template <typename Msg>
+    void Route(uint16_t pkt_id, Msg& msg, const uint32_t* handles, uint32_t count);
+
+public:
+    explicit GameOutputStage(boost::asio::io_context& io_context);
+    ~GameOutputStage();
+
+    GameOutputStage(const GameOutputStage&) = delete;
+    GameOutputStage& operator=(const GameOutputStage&) = delete;
+
+    // 새 이벤트 기록 (game_strand_ 전용)
+    OutputEvent& Emit(OutputEvent::Kind kind) {
+        if (!pending_) pending_ = AcquireBatch();
+
+        pending_->events.emplace_back();
+        OutputEvent& ev = pending_->events.back();
+        ev.kind = kind;
+        ev.handle_begin = static_cast<uint32_t>(pending_->handles.size());
+
+        if (!flush_scheduled_) ScheduleFlush();
+        return ev;
+    }
+
+    // 마지막으로 Emit한 이벤트에 수신자 추가 (0 = 미발급 핸들, 무시)
+    void AddRecipient(uint32_t handle) {
+        if (handle == 0) return;
+        pending_->handles.push_back(handle);
+        ++pending_->events.back().handle_count;
+    }
+
+    // 마지막으로 Emit한 이벤트에 가변 길이 문자열 첨부 (채팅 메시지 등)
+    void SetText(const std::string& text) {
+        OutputEvent& ev = pending_->events.back();
+        ev.text_begin = static_cast<uint32_t>(pending_->text.size());
+        ev.text_len = static_cast<uint32_t>(text.size());
+        pending_->text.append(text);
+    }
+
+    // 기록된 배치를 인코딩 단계로 넘김 (game_strand_ 전용)
+    void Flush();
+};
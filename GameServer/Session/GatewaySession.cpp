@@ -8,10 +8,23 @@
 using boost::asio::ip::tcp;
 
 GatewaySession::GatewaySession(tcp::socket socket) noexcept
-    : socket_(std::move(socket)), strand_(GameContext::Get().io_context) { }
+    : socket_(std::move(socket)), strand_(GameContext::Get().io_context)
+    , bundle_(static_cast<uint16_t>(Protocol::PKT_S2S_BUNDLE)) { }
 
 void GatewaySession::start() {
-    ReadHeader();
+    // S2S는 이미 번들 단위로 묶어서 보내므로 Nagle 지연을 끔
+    boost::system::error_code ec;
+    socket_.set_option(tcp::no_delay(true), ec);
+
+    DoRead();
+}
+
+void GatewaySession::Close() {
+    auto self(shared_from_this());
+    boost::asio::post(strand_, [this, self]() {
+        boost::system::error_code ec;
+        socket_.close(ec);
+    });
 }
 
 // ==========================================
@@ -27,69 +40,126 @@ void GatewaySession::start() {
 void GatewaySession::Send(uint16_t pktId, const google::protobuf::Message& msg) {
     if (!socket_.is_open()) return;
 
-    uint16_t payloadSize = static_cast<uint16_t>(msg.ByteSizeLong());
-    uint16_t totalSize = sizeof(PacketHeader) + payloadSize;
+    //   메모리 풀 버퍼에 1회 직렬화 (전송 완료 시 SendBufferDeleter가 자동 반납)
+    SharedPacket packet = MakeSharedPacket(pktId, msg);
 
     // 버퍼 크기 초과 시 서버 죽지 않도록 에러 로그만 띄우고 취소
-    if (totalSize > MAX_PACKET_SIZE) {
+    if (!packet.IsValid()) {
         LOG_ERROR("GameServer", "패킷 크기 초과! (PktID: " << pktId
-            << ", Size: " << totalSize << " bytes) - 전송 취소");
+            << ", Size: " << (sizeof(PacketHeader) + msg.ByteSizeLong()) << " bytes) - 전송 취소");
         return;
     }
 
-    //   메모리 풀에서 버퍼 대여 (전송 완료 시 SendBufferDeleter가 자동 반납)
-    SendBuffer* raw_buf = SendBufferPool::GetInstance().Acquire();
-    std::shared_ptr<SendBuffer> send_buf(raw_buf, SendBufferDeleter());
+    SendShared(packet);
+}
 
-    PacketHeader header{ totalSize, pktId };
-    memcpy(send_buf->buffer_.data(), &header, sizeof(PacketHeader));
-    msg.SerializeToArray(send_buf->buffer_.data() + sizeof(PacketHeader), payloadSize);
+// ==========================================
+//   SendShared() - 이미 직렬화된 공유 패킷 전송
+//
+// S2S는 암호화하지 않으므로(ENCRYPT_S2S = false) 세션별 가공 없이
+// 공유 버퍼를 그대로 번들에 넣습니다. (BroadcastToGateways 팬아웃)
+// 번들은 공유 버퍼를 읽기만 하므로 다른 세션과 공유해도 안전합니다.
+// ==========================================
+void GatewaySession::SendShared(const SharedPacket& packet) {
+    if (!socket_.is_open()) return;
 
     auto self(shared_from_this());
+    std::shared_ptr<SendBuffer> send_buf = packet.buffer;
+    uint16_t totalSize = packet.size;
 
-    //   람다 캡처에 totalSize를 추가합니다.
     boost::asio::post(strand_, [this, self, send_buf, totalSize]() {
         // [Backpressure] 큐가 SEND_QUEUE_MAX_SIZE 이상 쌓이면 서버가 뻗지 않도록 패킷 드랍
-        if (send_queue_.size() > GameConstants::Network::SEND_QUEUE_MAX_SIZE) {
+        if (send_queue_.Size() > GameConstants::Network::SEND_QUEUE_MAX_SIZE) {
             LOG_WARN("GameServer", "GatewaySession Send Queue 폭발! 전송 드랍.");
             return;
         }
 
-        bool write_in_progress = !send_queue_.empty();
+        EnqueueFrame(send_buf, totalSize);
+    });
+}
+
+// ==========================================
+//   EnqueueFrame / FlushBundle - S2S 번들 전송
+//
+// 변경 전: MoveRes/AttackRes 등 응답 1개 = 송신 큐 엔트리 1개 = S2S 프레임 1개
+// 변경 후: strand 턴 동안 들어온 응답을 번들 1개로 묶은 뒤 송신 큐에 넣음
+//   -> 첫 프레임이 들어올 때 strand에 플러시를 예약, 그 전까지 들어온 프레임은 같은 번들로
+//   -> 누적 크기가 S2S_BUNDLE_FLUSH_BYTES를 넘거나 자리가 없으면 즉시 플러시
+// ==========================================
+void GatewaySession::EnqueueFrame(std::shared_ptr<SendBuffer> frame, uint16_t frame_size) {
+    if (!bundle_.Fits(frame_size)) FlushBundle();
 
-        // =========================================================
-        // 큐의 형식에 맞게 버퍼와 사이즈를 pair로 넣습니다! (emplace_back 사용)
-        // =========================================================
-        send_queue_.emplace_back(send_buf, totalSize);
+    bundle_.Append(frame, frame_size);
 
-        if (!write_in_progress) {
-            DoWrite();
+    if (bundle_.Bytes() >= GameConstants::Network::S2S_BUNDLE_FLUSH_BYTES) {
+        FlushBundle();
+        return;
+    }
+
+    if (!bundle_flush_scheduled_) {
+        bundle_flush_scheduled_ = true;
+        auto self(shared_from_this());
+        boost::asio::post(strand_, [this, self]() {
+            bundle_flush_scheduled_ = false;
+            FlushBundle();
+        });
+    }
+}
+
+void GatewaySession::FlushBundle() {
+    if (bundle_.Empty()) return;
+
+    S2SBundleWriter::Flushed flushed = bundle_.Take();
+
+    // 협상된 링크에서 일정 크기 이상의 번들만 압축 (이득이 없으면 원본 유지)
+    if (flushed.count > 1 && flushed.size >= GameConstants::Network::S2S_COMPRESS_MIN_BYTES &&
+        (compression_flags_.load(std::memory_order_relaxed) & S2SCompression::FLAG_LZ4)) {
+        uint16_t compressed_size = 0;
+        auto compressed = S2SCompression::CompressFrame(flushed.buffer->Data(), flushed.size,
+            static_cast<uint16_t>(Protocol::PKT_S2S_BUNDLE_LZ4), compressed_size);
+        if (compressed) {
+            flushed.buffer = std::move(compressed);
+            flushed.size = compressed_size;
         }
-    });
+    }
+
+    bool write_in_progress = !send_queue_.Empty();
+    PushResult result = send_queue_.Push(std::move(flushed.buffer), flushed.size);
+    if (IsQueued(result) && !write_in_progress) {
+        DoWrite();
+    }
 }
 
-//   실제 비동기 전송을 수행하는 함수
+// gather write (SendQueue::PrepareBatch 참고)
 void GatewaySession::DoWrite() {
     auto self(shared_from_this());
-    auto& front_msg = send_queue_.front();
+
+    // 무효화 엔트리만 실린 배치 -> 빈 async_write 없이 즉시 정리 (SendQueue::PrepareBatch 참고)
+    auto batch = send_queue_.PrepareBatch();
+    if (batch.empty()) {
+        send_queue_.FinishBatch(true);
+        return;
+    }
 
     // bind_executor를 사용하여 콜백 또한 strand_ 내부에서 안전하게 실행되도록 보장합니다.
     boost::asio::async_write(socket_,
-        boost::asio::buffer(front_msg.first->buffer_.data(), front_msg.second),
+        batch,
         boost::asio::bind_executor(strand_, [this, self](boost::system::error_code ec, std::size_t) {
             if (!ec) {
-                // 방금 전송이 끝난 패킷을 큐에서 제거합니다.
-                send_queue_.pop_front();
+                // 방금 전송이 끝난 배치를 큐에서 제거합니다.
+                send_queue_.FinishBatch(true);
 
                 // 큐에 대기 중인 다음 패킷이 있다면 이어서 전송합니다. (꼬리물기)
-                if (!send_queue_.empty()) {
+                if (!send_queue_.Empty()) {
                     DoWrite();
                 }
             }
             else {
                 // 에러 발생 시 큐를 비워버립니다. 소켓 정리는 Read 쪽에서 처리됩니다.
                 LOG_ERROR("GameServer", "Gateway로 S2S 패킷 전송 실패 (DoWrite)");
-                send_queue_.clear();
+                send_queue_.FinishBatch(false);
+                send_queue_.Clear();
+                bundle_.Clear();
             }
         }));
 }
@@ -103,7 +173,7 @@ void GatewaySession::DoWrite() {
 //
 // 변경 후: game_strand_에 유저 일괄 정리 요청을 post
 //   -> gatewayPlayerMap_에서 소속 유저 목록을 조회
-//   -> playerMap, uidToAccount, Zone, Redis에서 일괄 삭제
+//   -> playerMap, uidToAccount, uidToPlayer, Zone, Redis에서 일괄 삭제
 //   -> 세션 라이프사이클(gatewaySessions)은 별도 뮤텍스로 즉시 정리
 // ==========================================
 void GatewaySession::OnDisconnected() {
@@ -124,6 +194,7 @@ void GatewaySession::OnDisconnected() {
                 float last_y = it->second->y;
 
                 ctx_inner.uidToAccount.erase(uid);
+                ctx_inner.uidToPlayer.erase(uid);
                 ctx_inner.playerMap.erase(it);
                 ctx_inner.zone->LeaveZone(uid, last_x, last_y);
                 RedisManager::GetInstance().RemovePlayer(acc_id);
@@ -152,36 +223,22 @@ void GatewaySession::OnDisconnected() {
 }
 
 // ==========================================
-//   ReadHeader - PacketAssembler 고정 버퍼 사용 + game_strand_ 디스패치
+//   DoRead - 스트리밍 수신 (async_read_some + 링 버퍼)
+//
+// 변경 전: async_read(헤더) -> async_read(페이로드) 2단계 수신
+//   -> Gateway가 수천 명분의 이동 패킷을 몰아서 보내도 1패킷당 recv 2회
 //
-// 변경 전: payload_buf_.resize(payload_size)로 동적 할당 후 수신
-// 변경 후: assembler_.GetBuffer()에 직접 수신 (고정 크기 사전 할당 버퍼)
+// 변경 후: 링 버퍼 빈 공간 전체로 async_read_some 1회 수신 후
+//          완성된 프레임을 ProcessFrames()에서 모두 처리
 // ==========================================
-void GatewaySession::ReadHeader() {
+void GatewaySession::DoRead() {
     auto self(shared_from_this());
-    boost::asio::async_read(socket_, boost::asio::buffer(&header_, sizeof(PacketHeader)),
+    socket_.async_read_some(stream_.GetWriteBuffers(),
         [this, self](boost::system::error_code ec, std::size_t length) {
             if (!ec) {
-                if (header_.size < sizeof(PacketHeader) || header_.size > MAX_PACKET_SIZE) return;
-                uint16_t payload_size = static_cast<uint16_t>(header_.size - sizeof(PacketHeader));
-
-                if (payload_size == 0) {
-                    //   game_strand_에 디스패치하여 게임 로직 직렬화
-                    uint16_t pkt_id = header_.id;
-                    boost::asio::post(GameContext::Get().game_strand_, [self, pkt_id]() {
-                        auto session_ptr = self;
-                        GameContext::Get().gatewayDispatcher.Dispatch(session_ptr, pkt_id, nullptr, 0);
-                    });
-                    ReadHeader();
-                }
-                else {
-                    //   고정 버퍼 크기 검증
-                    if (!assembler_.ValidatePayloadSize(payload_size)) {
-                        LOG_WARN("GameServer", "S2S 페이로드 크기가 고정 버퍼 범위 초과: " << payload_size);
-                        return;
-                    }
-                    ReadPayload(payload_size);
-                }
+                stream_.CommitWrite(length);
+                if (!ProcessFrames()) return;
+                DoRead();
             }
             else {
                 LOG_INFO("GameServer", "GatewayServer와의 S2S 연결 해제됨.");
@@ -191,35 +248,105 @@ void GatewaySession::ReadHeader() {
 }
 
 // ==========================================
-//   ReadPayload - PacketAssembler 고정 버퍼에 수신 후 복사본으로 game_strand_ 디스패치
+//   ProcessFrames - 읽기 1회분 프레임을 RecvBatch로 묶어 game_strand_에 1회 post
+//
+// 변경 전: 프레임마다 make_shared<vector<char>> 복사 + game_strand_ post
+// 변경 후: 풀에서 대여한 RecvBatch에 연속 복사 -> 배치 단위로 post, strand에서 순회 Dispatch
+//   -> 프레임 순서는 배치 내부 순서 + strand FIFO로 그대로 유지됨
+//
+// 링 버퍼는 다음 수신에서 덮어써지므로 post 전에 반드시 배치로 복사
+// 반환값: false면 더 이상 수신하지 않음 (헤더 크기 위반)
 //
-// 변경 전: payload_buf_.resize(payload_size) + 동적 버퍼에 수신
-// 변경 후: assembler_.GetBuffer()에 수신 후 복사본을 game_strand_에 post
+// [I/O 스레드 디코딩]
+// 변경 전: 이동/공격 등 모든 ParseFromArray와 좌표 보정이 game_strand_ 안에서 실행
+//   -> 서버 전체 처리량을 묶는 단일 직렬 구간이 protobuf 디코딩까지 떠안음
+// 변경 후: 타입 명령으로 등록된 패킷은 여기(I/O 스레드)에서 명령 구조체로 디코딩/검증
+//   -> 배치에는 구조체 바이트만 담고 strand는 InvokeCommand로 게임 로직만 실행
+//   -> 디코딩 실패(손상된 페이로드, 범위 밖 필드)는 strand에 들어가기 전에 폐기
 // ==========================================
-void GatewaySession::ReadPayload(uint16_t payload_size) {
+static void PostRecvBatch(const std::shared_ptr<GatewaySession>& self, std::shared_ptr<RecvBatch> batch) {
+    boost::asio::post(GameContext::Get().game_strand_, [self, batch]() {
+        auto session_ptr = self;
+        auto& dispatcher = GameContext::Get().gatewayDispatcher;
+        PacketArena::BatchScope arena_scope;    // 배치 내 요청 메시지는 끝에서 일괄 회수
+        batch->ForEach([&](uint16_t pkt_id, char* payload, uint16_t payload_size, bool decoded) {
+            if (decoded) {
+                if (auto* entry = dispatcher.Find(pkt_id)) {
+                    PacketDispatcher<GatewaySession>::InvokeCommand(*entry, session_ptr, payload);
+                }
+                return;
+            }
+            dispatcher.Dispatch(session_ptr, pkt_id, payload, payload_size);
+        });
+    });
+}
+
+bool GatewaySession::ProcessFrames() {
     auto self(shared_from_this());
-    boost::asio::async_read(socket_,
-        boost::asio::buffer(assembler_.GetBuffer(), payload_size),
-        [this, self, payload_size](boost::system::error_code ec, std::size_t length) {
-            if (!ec) {
-                // 페이로드 복사 (다음 ReadHeader가 assembler_ 버퍼를 덮어쓰기 전)
-                auto payload_copy = std::make_shared<std::vector<char>>(
-                    assembler_.GetPayloadData(), assembler_.GetPayloadData() + payload_size);
-                uint16_t pkt_id = header_.id;
-
-                // game_strand_에 디스패치하여 게임 로직 직렬화
-                boost::asio::post(GameContext::Get().game_strand_,
-                    [self, pkt_id, payload_copy, payload_size]() {
-                        auto session_ptr = self;
-                        GameContext::Get().gatewayDispatcher.Dispatch(
-                            session_ptr, pkt_id, payload_copy->data(), payload_size);
-                    });
-
-                ReadHeader();
+    auto& dispatcher = GameContext::Get().gatewayDispatcher;
+    PacketArena::BatchScope arena_scope;    // I/O 스레드 디코딩용 임시 메시지 회수
+    std::shared_ptr<RecvBatch> batch;
+    bool valid = true;
+
+    auto append_frame = [&](uint16_t id, const char* data, uint16_t size, bool decoded) {
+        if (!batch) batch = RecvBatchPool::GetInstance().Acquire();
+
+        // 배치 용량 초과 시 지금까지 모은 배치를 먼저 넘기고 새 배치로 이어감
+        if (!batch->Append(id, data, size, decoded)) {
+            PostRecvBatch(self, std::move(batch));
+            batch = RecvBatchPool::GetInstance().Acquire();
+            batch->Append(id, data, size, decoded);
+        }
+    };
+
+    auto append = [&](uint16_t id, const char* payload, uint16_t payload_size) {
+        const auto* entry = dispatcher.Find(id);
+        if (entry && entry->IsCommand()) {
+            PacketDispatcher<GatewaySession>::CommandBuffer command;
+            if (!PacketDispatcher<GatewaySession>::DecodeCommand(*entry, payload, payload_size, command)) {
+                return;     // 디코더가 사유를 로그로 남김, 프레임은 폐기
             }
-            else {
-                LOG_ERROR("GameServer", "GatewayServer와의 연결이 끊어졌습니다.");
-                OnDisconnected();
+            append_frame(id, command.bytes, entry->command_size, true);
+            return;
+        }
+        append_frame(id, payload, payload_size, false);
+    };
+
+    PacketFrame frame;
+    while (true) {
+        FrameResult result = stream_.PeekFrame(frame);
+        if (result == FrameResult::INCOMPLETE) break;
+
+        if (result == FrameResult::INVALID) {
+            LOG_WARN("GameServer", "잘못된 S2S 패킷 헤더 크기: " << frame.size);
+            valid = false;
+            break;
+        }
+
+        // 번들 프레임은 서브 메시지를 풀어서 같은 배치에 순서대로 담음
+        if (frame.id == Protocol::PKT_S2S_BUNDLE) {
+            if (!ForEachBundled(frame.payload, frame.payload_size, append)) {
+                LOG_WARN("GameServer", "손상된 S2S 번들 수신 (size: " << frame.payload_size << ")");
             }
-        });
+        }
+        else if (frame.id == Protocol::PKT_S2S_BUNDLE_LZ4) {
+            // 복원 버퍼는 배치에 복사된 뒤 버려지므로 스택 사용
+            char raw[MAX_PACKET_SIZE];
+            int raw_size = S2SCompression::DecompressPayload(frame.payload, frame.payload_size, raw, sizeof(raw));
+            if (raw_size < 0 || !ForEachBundled(raw, static_cast<uint16_t>(raw_size), append)) {
+                LOG_WARN("GameServer", "압축 S2S 번들 복원 실패 (size: " << frame.payload_size << ")");
+            }
+        }
+        else {
+            append(frame.id, frame.payload, frame.payload_size);
+        }
+
+        stream_.ConsumeFrame(frame);
+    }
+
+    // 헤더 위반 이전까지 정상 수신한 프레임은 처리
+    if (batch && !batch->Empty()) {
+        PostRecvBatch(self, std::move(batch));
+    }
+    return valid;
 }
@@ -2,6 +2,7 @@
 #include <boost/asio.hpp>
 #include <memory>
 #include <vector>
+#include <atomic>
 
 #include <deque>   //   큐 사용
 #include <utility> //   std::pair 사용
@@ -9,6 +10,11 @@
 #include <google/protobuf/message.h>
 #include "../GameServer.h"
 #include "../../Common/Network/PacketAssembler.h"
+#include "../../Common/Network/SendQueue.h"
+#include "../../Common/Network/SharedPacket.h"
+#include "../../Common/Network/RecvBatch.h"
+#include "../../Common/Network/S2SBundle.h"
+#include "../../Common/Network/S2SCompression.h"
 
 struct SendBuffer; // 전방 선언
 
@@ -20,24 +26,56 @@ private:
     boost::asio::io_context::strand strand_;
 
     //   패킷 전송 대기열 (버퍼 포인터와 실제 전송할 크기를 묶어서 보관)
-    std::deque<std::pair<std::shared_ptr<SendBuffer>, size_t>> send_queue_;
+    //   -> DoWrite() 시 쌓인 패킷을 gather write 1회로 묶어서 전송
+    SendQueue send_queue_;
 
-    PacketHeader header_;
+    //   S2S 번들: 같은 strand 턴에 쌓인 응답을 프레임 1개로 묶어서 전송 (strand_ 전용)
+    S2SBundleWriter bundle_;
+    bool bundle_flush_scheduled_ = false;
 
-    //   std::vector<char> payload_buf_ 제거 -> PacketAssembler로 교체
-    // S2S 통신 수신 버퍼를 고정 크기로 변경하여 동적 할당 제거
-    PacketAssembler assembler_;
+    //   S2S 스트리밍 수신 링 버퍼 (async_read_some 1회에 여러 프레임 처리)
+    PacketStreamAssembler<GameConstants::Network::S2S_RECV_RING_SIZE> stream_;
+
+    //   S2S 레인 식별 (GatewayGameLaneHello 수신 시 설정)
+    //   BroadcastToGateways는 대표 레인(lane_index 0)만 대상으로 하므로,
+    //   Hello를 받기 전까지는 브로드캐스트 대상에서 제외됨
+    std::atomic<uint32_t> gateway_id_{ 0 };
+    std::atomic<uint32_t> lane_index_{ 0 };
+    std::atomic<bool> lane_identified_{ false };
+
+    //   협상된 S2S 압축 코덱 (LaneHello 수신 시 설정)
+    std::atomic<uint32_t> compression_flags_{ 0 };
 
 public:
     GatewaySession(boost::asio::ip::tcp::socket socket) noexcept;
     void start();
     void Send(uint16_t pktId, const google::protobuf::Message& msg);
+    void SendShared(const SharedPacket& packet);
+
+    //   연결 강제 종료 (대기 중인 수신이 에러로 끝나며 OnDisconnected에서 정리)
+    void Close();
+
+    void SetLaneInfo(uint32_t gateway_id, uint32_t lane_index) {
+        gateway_id_.store(gateway_id, std::memory_order_relaxed);
+        lane_index_.store(lane_index, std::memory_order_relaxed);
+        lane_identified_.store(true, std::memory_order_release);
+    }
+    void SetCompressionFlags(uint32_t flags) { compression_flags_.store(flags, std::memory_order_relaxed); }
+    uint32_t GetGatewayId() const { return gateway_id_.load(std::memory_order_relaxed); }
+    bool IsPrimaryLane() const {
+        return lane_identified_.load(std::memory_order_acquire) &&
+               lane_index_.load(std::memory_order_relaxed) == 0;
+    }
 
 private:
-    void ReadHeader();
-    void ReadPayload(uint16_t payload_size);
+    void DoRead();
+    bool ProcessFrames();
+
+    //   프레임을 번들에 추가하고 필요 시 플러시 예약 (strand_ 안에서만 호출)
+    void EnqueueFrame(std::shared_ptr<SendBuffer> frame, uint16_t frame_size);
+    void FlushBundle();
 
-    //   큐에서 패킷을 꺼내 실제로 전송하는 내부 함수
+    //   큐에 쌓인 패킷을 묶어서 실제로 전송하는 내부 함수
     void DoWrite();
 
     //   연결 끊김 시 메모리 회수를 전담할 중앙 처리 함수
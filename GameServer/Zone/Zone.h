@@ -1,12 +1,16 @@
 ﻿#pragma once
 
 #include <vector>
+#include <array>
 #include <unordered_set>
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <functional>
 #include <cassert>
 
+#include "../../Common/Define/GameConstants.h"
+
 #ifndef NDEBUG
 #include <atomic>
 #endif
@@ -103,6 +107,141 @@ struct Sector {
     }
 };
 
+// ==========================================
+//   AOI 거리 기반 갱신 주기(LOD)
+//
+// 변경 전: 이동 1회마다 AOI(3x3 섹터) 안의 모든 관찰자에게 동일하게 전송
+//   -> 바로 옆 유저와 100m 밖 유저가 같은 빈도로 패킷을 받음
+//   -> 밀집 지역에서 팬아웃 바이트가 관찰자 수에 정비례로 증가
+//
+// 변경 후: 관찰자-이동자 거리로 대역을 나누어 전송 빈도를 차등 적용
+//   -> NEAR(near_radius 이내): 매 이동마다 전송
+//   -> MID (mid_radius 이내): mid_interval번 중 1번 전송
+//   -> FAR (그 밖, AOI 안):   far_interval번 중 1번 전송
+//   -> 관찰자 uid를 위상(phase)으로 섞어 원거리 관찰자들이 같은 이동에
+//      몰리지 않도록 분산
+//   -> 건너뛴 관찰자가 있는 이동 후 settle_ms 동안 추가 이동이 없으면(정지)
+//      AOI 전체에 최종 위치를 1회 전송 (FlushSettledPlayerMoves, AI Tick에서 호출)
+//      -> 마지막 이동이 주기 사이에 떨어져도 MID/FAR 관찰자에게 옛 위치가 남지 않음
+//
+// 대역 판정은 AOI 조회 결과를 그대로 사용하므로 추가 공간 질의 없음
+// 맵(Zone)마다 별도 설정을 가질 수 있음 (Zone::SetLodConfig)
+// ==========================================
+struct AoiLodConfig {
+    float    near_radius   = GameConstants::Map::AOI_LOD_NEAR_RADIUS;
+    float    mid_radius    = GameConstants::Map::AOI_LOD_MID_RADIUS;
+    uint32_t mid_interval  = GameConstants::Map::AOI_LOD_MID_INTERVAL;
+    uint32_t far_interval  = GameConstants::Map::AOI_LOD_FAR_INTERVAL;
+    uint32_t settle_ms     = GameConstants::Map::AOI_LOD_SETTLE_MS;
+
+    // 거리 제곱으로 해당 대역의 전송 주기 반환 (1 = 매번)
+    uint32_t IntervalFor(float dist_sq) const {
+        if (dist_sq <= near_radius * near_radius) return 1;
+        if (dist_sq <= mid_radius * mid_radius) return mid_interval;
+        return far_interval;
+    }
+
+    // move_seq: 이동자의 이동 순번, phase: 관찰자별 분산 값 (보통 관찰자 uid)
+    bool ShouldSend(float dist_sq, uint32_t move_seq, uint64_t phase) const {
+        uint32_t interval = IntervalFor(dist_sq);
+        if (interval <= 1) return true;
+        return ((move_seq + static_cast<uint32_t>(phase)) % interval) == 0;
+    }
+};
+
+// ==========================================
+//   예산형 AOI 수신자 선택 (N명 최근접 + 우선순위 힌트)
+//
+// 변경 전: GetPlayersInAOI()로 AOI 전체를 vector에 담은 뒤
+//   앞에서부터 MAX_AOI_BROADCAST명에서 잘라냄
+//   -> 잘리는 기준이 unordered_set 순회 순서라 누가 받는지 사실상 무작위
+//   -> 잘려 나갈 인원까지 포함한 중간 vector를 매번 생성
+//
+// 변경 후: ForEachPlayerInAOI 순회 중 고정 크기 최대 힙(점수 기준)에 바로 넣음
+//   -> 힙이 예산만큼 차면 가장 먼(점수가 큰) 후보만 교체 (O(K log N), 할당 없음)
+//   -> 점수 = 거리 제곱, 우선순위 힌트 대상(본인, 현재 타겟, 파티원 등)은 음수 점수로
+//      거리와 무관하게 항상 먼저 선택됨
+//   -> 팬아웃 상한(서버 보호)은 그대로, 실제로 중요한 관찰자가 업데이트를 받음
+//
+// [사용 예] (game_strand_ 안에서)
+//   AoiBroadcastSelector selector;
+//   ctx.zone->SelectPlayersInAOI(x, y, selector, [&](uint64_t uid, AoiCandidate& out) { ... return true; });
+//   selector.ForEach([&](const AoiCandidate& c) { msg.add_target_handles(c.handle); });
+// ==========================================
+struct AoiCandidate {
+    uint64_t uid = 0;
+    uint32_t handle = 0;    // 수신자 세션 핸들
+    float score = 0.0f;     // 작을수록 우선 (거리 제곱, 힌트 대상은 음수)
+};
+
+// 항상 포함할 관찰자 uid 목록 (본인, 현재 타겟, 파티원 등, 최대 MAX_HINTS개)
+class AoiPriorityHints {
+public:
+    static constexpr size_t MAX_HINTS = 8;
+    static constexpr float PRIORITY_SCORE = -1.0f;
+
+private:
+    std::array<uint64_t, MAX_HINTS> uids_{};
+    size_t count_ = 0;
+
+public:
+    void Add(uint64_t uid) {
+        if (uid != 0 && count_ < MAX_HINTS) uids_[count_++] = uid;
+    }
+
+    bool Contains(uint64_t uid) const {
+        for (size_t i = 0; i < count_; ++i) {
+            if (uids_[i] == uid) return true;
+        }
+        return false;
+    }
+
+    // 힌트 대상이면 우선 점수, 아니면 거리 제곱
+    float Score(uint64_t uid, float dist_sq) const {
+        return Contains(uid) ? PRIORITY_SCORE : dist_sq;
+    }
+};
+
+template <size_t N>
+class AoiRecipientSelector {
+private:
+    std::array<AoiCandidate, N> heap_{};    // score 기준 최대 힙 (루트 = 현재 가장 먼 후보)
+    size_t size_ = 0;
+    size_t budget_;
+
+    static bool Less(const AoiCandidate& a, const AoiCandidate& b) { return a.score < b.score; }
+
+public:
+    explicit AoiRecipientSelector(size_t budget = N) : budget_(budget < N ? budget : N) {}
+
+    void Offer(const AoiCandidate& candidate) {
+        if (budget_ == 0) return;
+
+        if (size_ < budget_) {
+            heap_[size_++] = candidate;
+            std::push_heap(heap_.begin(), heap_.begin() + size_, Less);
+            return;
+        }
+
+        // 예산이 찼으면 현재 가장 먼 후보보다 가까울 때만 교체
+        if (!(candidate.score < heap_[0].score)) return;
+        std::pop_heap(heap_.begin(), heap_.begin() + size_, Less);
+        heap_[size_ - 1] = candidate;
+        std::push_heap(heap_.begin(), heap_.begin() + size_, Less);
+    }
+
+    size_t Size() const { return size_; }
+
+    // 선택된 후보 순회 (순서 무관)
+    template <typename Func>
+    void ForEach(Func&& func) const {
+        for (size_t i = 0; i < size_; ++i) func(heap_[i]);
+    }
+};
+
+// 팬아웃 상한(MAX_AOI_BROADCAST) 크기의 기본 선택기
+using AoiBroadcastSelector = AoiRecipientSelector<static_cast<size_t>(GameConstants::Network::MAX_AOI_BROADCAST)>;
+
 class Zone {
 private:
     int width_;
@@ -113,9 +252,14 @@ private:
 
     std::vector<std::vector<std::unique_ptr<Sector>>> grid_;
 
+    AoiLodConfig lod_config_;
+
 public:
     Zone(int width, int height, int sector_size);
 
+    void SetLodConfig(const AoiLodConfig& config) { lod_config_ = config; }
+    const AoiLodConfig& GetLodConfig() const { return lod_config_; }
+
     bool GetSectorIndex(float x, float y, int& out_row, int& out_col) const;
     
     void EnterZone(uint64_t player_id, float x, float y);
@@ -138,6 +282,17 @@ public:
         }
     }
 
+    //   예산형 AOI 조회: AOI 순회 중 바로 selector에 넣음 (중간 vector 없음)
+    //   fill(uid, AoiCandidate& out): handle/score를 채우고 후보로 넣을지 여부 반환
+    template<size_t N, typename FillFunc>
+    void SelectPlayersInAOI(float x, float y, AoiRecipientSelector<N>& selector, FillFunc&& fill) const {
+        ForEachPlayerInAOI(x, y, [&](uint64_t uid) {
+            AoiCandidate candidate;
+            candidate.uid = uid;
+            if (fill(uid, candidate)) selector.Offer(candidate);
+        });
+    }
+
     void EnterZoneMonster(uint64_t mon_id, float x, float y);
     void LeaveZoneMonster(uint64_t mon_id, float x, float y);
     void UpdatePositionMonster(uint64_t mon_id, float old_x, float old_y, float new_x, float new_y);
@@ -5,6 +5,9 @@
 #include "Handlers/GameGateway/GameHandlers.h"
 #include "../Common/ConfigManager.h"
 #include "../Common/MemoryPool.h"
+#include "../Common/Network/IoContextPool.h"
+#include "../Common/Network/TimingWheel.h"
+#include "../Common/Define/GameConstants.h"
 
 #include <iostream>
 #include <windows.h>
@@ -14,17 +17,27 @@ using boost::asio::ip::tcp;
 
 class GatewayServer {
     tcp::acceptor acceptor_;
+    IoContextPool* session_pool_ = nullptr;   // 설정 시 accept한 소켓을 풀의 io_context에 분배
 public:
     GatewayServer(boost::asio::io_context& io_context, short port)
         : acceptor_(io_context, tcp::endpoint(tcp::v4(), port)) {
         do_accept();
     }
+
+    // thread-per-core 모드: SO_REUSEPORT acceptor(코어별) 또는 단일 acceptor + 풀 분배
+    GatewayServer(tcp::acceptor acceptor, IoContextPool* session_pool)
+        : acceptor_(std::move(acceptor)), session_pool_(session_pool) {
+        do_accept();
+    }
 private:
     void do_accept() {
-        acceptor_.async_accept([this](boost::system::error_code ec, tcp::socket socket) {
+        auto on_accept = [this](boost::system::error_code ec, tcp::socket socket) {
             if (!ec) std::make_shared<ClientSession>(std::move(socket))->start();
             do_accept();
-            });
+            };
+
+        if (session_pool_) acceptor_.async_accept(session_pool_->GetNext(), on_accept);
+        else               acceptor_.async_accept(on_accept);
     }
 };
 
@@ -47,33 +60,88 @@ int main() {
     SendBufferPool::GetInstance().Initialize(PoolConfig::HEAVY_SERVER);
 
     auto& ctx = GatewayContext::Get();
+    ctx.gatewayId = static_cast<uint32_t>(ConfigManager::GetInstance().GetGatewayId());   // 범위는 LoadConfig에서 검증
 
     // Client -> Gateway 핸들러 등록
-    ctx.clientDispatcher.RegisterHandler(Protocol::PKT_CLIENT_GATEWAY_CONNECT_REQ, Handle_GatewayConnectReq);
-    ctx.clientDispatcher.RegisterHandler(Protocol::PKT_CLIENT_GATEWAY_CHAT_REQ,    Handle_ChatReq);
-    ctx.clientDispatcher.RegisterHandler(Protocol::PKT_CLIENT_GATEWAY_MOVE_REQ,    Handle_MoveReq);
-    ctx.clientDispatcher.RegisterHandler(Protocol::PKT_CLIENT_GATEWAY_ATTACK_REQ,  Handle_AttackReq);
+    ctx.clientDispatcher.RegisterHandler<&Handle_GatewayConnectReq>(Protocol::PKT_CLIENT_GATEWAY_CONNECT_REQ);
+    ctx.clientDispatcher.RegisterHandler<&Handle_ChatReq>(Protocol::PKT_CLIENT_GATEWAY_CHAT_REQ);
+    ctx.clientDispatcher.RegisterHandler<&Handle_MoveReq>(Protocol::PKT_CLIENT_GATEWAY_MOVE_REQ);
+    ctx.clientDispatcher.RegisterHandler<&Handle_AttackReq>(Protocol::PKT_CLIENT_GATEWAY_ATTACK_REQ);
 
     // Game -> Gateway 핸들러 등록
-    ctx.gameDispatcher.RegisterHandler(Protocol::PKT_GAME_GATEWAY_MOVE_RES,          Handle_MoveRes_FromGame);
-    ctx.gameDispatcher.RegisterHandler(Protocol::PKT_GAME_GATEWAY_ATTACK_RES,        Handle_GameGatewayAttackRes);
-    ctx.gameDispatcher.RegisterHandler(Protocol::PKT_GAME_GATEWAY_TOKEN_NOTIFY,      Handle_TokenNotify_FromGame);   //   토큰 통지
-    ctx.gameDispatcher.RegisterHandler(Protocol::PKT_GAME_GATEWAY_CHAT_RES,          Handle_ChatRes_FromGame);       //   채팅 AOI 응답
+    ctx.gameDispatcher.RegisterHandler<&Handle_MoveRes_FromGame>(Protocol::PKT_GAME_GATEWAY_MOVE_RES);
+    ctx.gameDispatcher.RegisterHandler<&Handle_GameGatewayAttackRes>(Protocol::PKT_GAME_GATEWAY_ATTACK_RES);
+    ctx.gameDispatcher.RegisterHandler<&Handle_TokenNotify_FromGame>(Protocol::PKT_GAME_GATEWAY_TOKEN_NOTIFY);         //   토큰 통지
+    ctx.gameDispatcher.RegisterHandler<&Handle_ChatRes_FromGame>(Protocol::PKT_GAME_GATEWAY_CHAT_RES);                 //   채팅 AOI 응답
+    ctx.gameDispatcher.RegisterHandler<&Handle_LaneHelloAck_FromGame>(Protocol::PKT_GAME_GATEWAY_LANE_HELLO_ACK);      //   S2S 압축 협상
 
     try {
         boost::asio::io_context io_context;
 
-        ctx.gameConnection = std::make_shared<GameConnection>(std::ref(io_context));
+        unsigned int max_thread_count = ConfigManager::GetInstance().GetGatewayMaxThreadCount();
+        if (max_thread_count == 0) max_thread_count = std::thread::hardware_concurrency();
+
+        // ==========================================
+        //   thread-per-core 모드 (gateway_server_info.thread_per_core)
+        //
+        // 코어(max_thread_count)마다 io_context + 전용 스레드 1개
+        //   -> 클라이언트 세션과 S2S 레인이 자기 코어에 고정되어 캐시 지역성 유지
+        //   -> 공유 io_context(기존 모드)는 사용하지 않음
+        // ==========================================
+        bool per_core = ConfigManager::GetInstance().IsGatewayThreadPerCore();
+        std::unique_ptr<IoContextPool> core_pool;
+        if (per_core) {
+            core_pool = std::make_unique<IoContextPool>(max_thread_count);
+        }
+
+        // 클라이언트 유휴 검사용 공용 타이밍 휠 (thread-per-core 모드는 0번 코어에서 tick)
+        //   -> guard가 io_context/core_pool보다 먼저 소멸하며 휠 타이머를 해제
+        TimingWheel::ShutdownGuard wheel_guard;
+        TimingWheel::GetInstance().Start(per_core ? core_pool->Get(0) : io_context,
+            std::chrono::milliseconds(GameConstants::Network::TIMING_WHEEL_TICK_MS));
+
+        // GameServer S2S 레인 N개 연결 (유저는 account_id 해시로 레인 고정)
         short game_port = ConfigManager::GetInstance().GetGatewayGameConnPort();
-        ctx.gameConnection->Connect("127.0.0.1", game_port);
+        int lane_count = ConfigManager::GetInstance().GetGatewayGameLaneCount();
+        if (lane_count < 1) lane_count = 1;
+
+        for (int lane = 0; lane < lane_count; ++lane) {
+            auto& lane_io = per_core ? core_pool->Get(static_cast<size_t>(lane)) : io_context;
+            auto conn = std::make_shared<GameConnection>(std::ref(lane_io),
+                static_cast<uint32_t>(lane), static_cast<uint32_t>(lane_count));
+            ctx.gameConnections.push_back(conn);
+            conn->Connect("127.0.0.1", game_port);
+        }
 
         short gateway_port = ConfigManager::GetInstance().GetGatewayServerPort();
-        GatewayServer server(io_context, gateway_port);
+        std::vector<std::unique_ptr<GatewayServer>> servers;
+        if (!per_core) {
+            servers.push_back(std::make_unique<GatewayServer>(io_context, gateway_port));
+        }
+        else if (IoContextPoolUtil::HAS_REUSE_PORT) {
+            // 코어마다 같은 포트의 acceptor -> 커널이 연결을 분산, 세션은 accept한 코어에 고정
+            for (size_t i = 0; i < core_pool->Size(); ++i) {
+                servers.push_back(std::make_unique<GatewayServer>(
+                    IoContextPoolUtil::OpenAcceptor(core_pool->Get(i), gateway_port, true), nullptr));
+            }
+        }
+        else {
+            // SO_REUSEPORT 미지원: acceptor 1개가 라운드 로빈으로 코어에 분배
+            servers.push_back(std::make_unique<GatewayServer>(
+                IoContextPoolUtil::OpenAcceptor(core_pool->Get(0), gateway_port, false), core_pool.get()));
+        }
         std::cout << "[GatewayServer] 게임 게이트웨이 서버 가동 시작 (Port:" << gateway_port << ") Created by Jeong Shin Young\n";
+        if (per_core) {
+            std::cout << "[GatewayServer] thread-per-core 모드: io_context " << core_pool->Size() << "개 ("
+                << (IoContextPoolUtil::HAS_REUSE_PORT ? "SO_REUSEPORT acceptor" : "단일 acceptor 분배") << ")\n";
+        }
         std::cout << "=================================================\n";
 
-        unsigned int max_thread_count = ConfigManager::GetInstance().GetGatewayMaxThreadCount();
-        if (max_thread_count == 0) max_thread_count = std::thread::hardware_concurrency();
+        if (per_core) {
+            core_pool->Run();
+            core_pool->Join();
+            return 0;
+        }
 
         std::vector<std::thread> threads;
         for (unsigned int i = 0; i < max_thread_count; ++i) {
@@ -3,6 +3,7 @@
 #include <memory>
 #include <vector>
 #include <unordered_map>
+#include <deque>
 #include <mutex>
 #include <string>
 #include <chrono>
@@ -10,6 +11,7 @@
 #include "..\Common\Protocol\protocol.pb.h"
 #include "PacketDispatcher.h"
 #include "..\Common\Utils\Lock.h"
+#include "..\Common\Define\GameConstants.h"
 
 #pragma pack(push, 1)
 struct PacketHeader {
@@ -36,12 +38,105 @@ struct GatewayContext {
     PacketDispatcher<ClientSession>  clientDispatcher;
     PacketDispatcher<GameConnection> gameDispatcher;
 
-    std::shared_ptr<GameConnection> gameConnection;
+    // ==========================================
+    //   GameServer S2S 다중 레인
+    //
+    // 변경 전: std::shared_ptr<GameConnection> gameConnection 1개
+    //   -> 모든 유저의 이동/공격/채팅이 소켓 1개 + strand 1개로 직렬화
+    //   -> Gateway의 S2S 처리량이 코어 1개 분량으로 제한
+    //
+    // 변경 후: 레인 N개(game_conn_lane_count)를 병렬로 연결
+    //   -> 유저는 account_id 해시로 레인에 고정 배정 (유저별 순서 보장)
+    //   -> 레인마다 독립된 소켓/strand/송신 큐/수신 경로
+    //
+    // gameConnections는 main()에서 io_context.run() 전에 구성되고 이후 변경되지 않음
+    // ==========================================
+    std::vector<std::shared_ptr<GameConnection>> gameConnections;
+
+    GameConnection* GetGameConnection(const std::string& account_id) const {
+        if (gameConnections.empty()) return nullptr;
+        size_t lane = std::hash<std::string>{}(account_id) % gameConnections.size();
+        return gameConnections[lane].get();
+    }
 
     std::unordered_map<std::string, std::shared_ptr<ClientSession>> clientMap;
     UTILITY::Lock clientMutex;
 
-    
+    // ==========================================
+    //   세션 핸들 테이블 (팬아웃 대상 주소 지정용)
+    //
+    // 변경 전: GameServer가 팬아웃 대상을 repeated string account_id로 전달
+    //   -> S2S 패킷에 수신자 수 × 문자열 길이만큼 바이트 증가
+    //   -> Gateway는 수신자마다 clientMap 문자열 해시 조회
+    //
+    // 변경 후: 접속(GatewayConnectReq 성공) 시 세션마다 uint32 핸들 발급
+    //   -> [상위 8비트: gatewayId][4비트: 세대][하위 20비트: handleTable 슬롯]
+    //   -> GameServer는 PlayerInfo에 핸들을 보관하고 packed uint32 목록으로 응답
+    //   -> Gateway는 배열 인덱스로 세션을 O(1) 조회
+    //   -> gatewayId 태그로 다른 Gateway의 핸들을 잘못 해석하지 않음
+    //
+    // 슬롯 반환 시 세대를 올리고 조회 시 세대를 비교하므로, GameServer가 LeaveReq를
+    // 처리하기 전까지 들고 있는 끊긴 세션의 핸들이 같은 슬롯의 새 세션으로 전달되지 않음
+    // 반환된 슬롯은 FIFO로 재사용하여 세대가 한 바퀴 도는 간격도 최대한 늘림
+    //
+    // 모든 함수는 clientMutex를 보유한 상태에서 호출해야 함
+    // ==========================================
+    static constexpr uint32_t HANDLE_INDEX_BITS = GameConstants::Network::SESSION_HANDLE_INDEX_BITS;
+    static constexpr uint32_t HANDLE_SLOT_BITS = HANDLE_INDEX_BITS - GameConstants::Network::SESSION_HANDLE_GENERATION_BITS;
+    static constexpr uint32_t HANDLE_SLOT_MASK = (1u << HANDLE_SLOT_BITS) - 1;
+    static constexpr uint32_t HANDLE_GENERATION_MASK = (1u << GameConstants::Network::SESSION_HANDLE_GENERATION_BITS) - 1;
+    static constexpr uint32_t INVALID_SESSION_HANDLE = 0;
+
+    uint32_t gatewayId = 1;
+    std::vector<std::shared_ptr<ClientSession>> handleTable{ nullptr };  // 0번 슬롯은 무효 핸들용
+    std::vector<uint8_t> handleGenerations{ 0 };                         // handleTable과 같은 크기
+    std::deque<uint32_t> freeHandleSlots;
+
+    uint32_t MakeSessionHandle(uint32_t slot) const {
+        return (gatewayId << HANDLE_INDEX_BITS)
+            | (static_cast<uint32_t>(handleGenerations[slot]) << HANDLE_SLOT_BITS) | slot;
+    }
+
+    uint32_t AllocateSessionHandle(const std::shared_ptr<ClientSession>& session) {
+        uint32_t slot = 0;
+        if (!freeHandleSlots.empty()) {
+            slot = freeHandleSlots.front();
+            freeHandleSlots.pop_front();
+        }
+        else {
+            if (handleTable.size() > HANDLE_SLOT_MASK) return INVALID_SESSION_HANDLE;
+            slot = static_cast<uint32_t>(handleTable.size());
+            handleTable.push_back(nullptr);
+            handleGenerations.push_back(0);
+        }
+        handleTable[slot] = session;
+        return MakeSessionHandle(slot);
+    }
+
+    void ReleaseSessionHandle(uint32_t handle) {
+        uint32_t slot = handle & HANDLE_SLOT_MASK;
+        if (slot == 0 || slot >= handleTable.size() || !handleTable[slot]) return;
+        if (MakeSessionHandle(slot) != handle) return;     // 다른 Gateway 또는 이미 반환된 세대
+
+        handleTable[slot].reset();
+        handleGenerations[slot] = static_cast<uint8_t>((handleGenerations[slot] + 1) & HANDLE_GENERATION_MASK);
+        freeHandleSlots.push_back(slot);
+    }
+
+    // 압축 이동 코덱 엔티티 ID: 이 Gateway가 발급한 핸들이면 슬롯만 (varint 1~3바이트)
+    //   -> 다른 Gateway 소속 핸들은 슬롯이 겹칠 수 있으므로 0 (기존 MoveRes 경로 사용)
+    //   -> 슬롯 재사용은 관찰자 인코더가 account_hash로 감지하므로 세대는 싣지 않음
+    //   -> gatewayId/슬롯만 보므로 clientMutex 불필요
+    uint32_t CompactEntityOf(uint32_t handle) const {
+        if ((handle >> HANDLE_INDEX_BITS) != gatewayId) return 0;
+        return handle & HANDLE_SLOT_MASK;
+    }
+
+    ClientSession* FindSessionByHandle(uint32_t handle) const {
+        uint32_t slot = handle & HANDLE_SLOT_MASK;
+        if (slot >= handleTable.size() || MakeSessionHandle(slot) != handle) return nullptr;
+        return handleTable[slot].get();
+    }
 
     //   세션 토큰 검증용 저장소
     // Key: account_id, Value: PendingToken
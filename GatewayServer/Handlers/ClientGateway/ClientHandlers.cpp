@@ -18,7 +18,7 @@
 // 클라이언트도 이 응답을 수신한 뒤 동일한 패스프레이즈로 암호화를 활성화합니다.
 // ==========================================
 void Handle_GatewayConnectReq(std::shared_ptr<ClientSession>& session, char* payload, uint16_t payloadSize) {
-    Protocol::GatewayConnectReq req;
+    auto& req = *PacketArena::Create<Protocol::GatewayConnectReq>();
 
     if (!req.ParseFromArray(payload, payloadSize)) {
         LOG_ERROR("Gateway", "ParseFromArray 실패: GatewayConnectReq (payloadSize=" << payloadSize << ")");
@@ -31,6 +31,17 @@ void Handle_GatewayConnectReq(std::shared_ptr<ClientSession>& session, char* pay
 
     auto& ctx = GatewayContext::Get();
 
+    // 이미 입장한 세션의 재요청은 거부 (기존 핸들 슬롯이 반환되지 않은 채 덮어써지는 것 방지)
+    if (!session->GetAccountId().empty()) {
+        LOG_WARN("Gateway", "중복 접속 요청 거부 (유저: " << session->GetAccountId() << ")");
+
+        Protocol::GatewayConnectRes res;
+        res.set_success(false);
+        res.set_reason("Already connected");
+        session->Send(Protocol::PKT_GATEWAY_CLIENT_CONNECT_RES, res);
+        return;
+    }
+
     // 토큰 검증
     bool token_valid = ctx.VerifyAndConsumeToken(req.account_id(), req.session_token());
     if (!token_valid) {
@@ -43,16 +54,39 @@ void Handle_GatewayConnectReq(std::shared_ptr<ClientSession>& session, char* pay
         return;
     }
 
-    session->SetAccountId(req.account_id());
-
+    // 팬아웃 주소 지정용 세션 핸들 발급 (발급 성공 시에만 clientMap 등록)
+    uint32_t handle = GatewayContext::INVALID_SESSION_HANDLE;
     {
         UTILITY::LockGuard lock(ctx.clientMutex);
-        ctx.clientMap[req.account_id()] = session;
+        handle = ctx.AllocateSessionHandle(session);
+        if (handle != GatewayContext::INVALID_SESSION_HANDLE) {
+            ctx.clientMap[req.account_id()] = session;
+        }
     }
 
+    // 핸들이 없으면 팬아웃(이동/공격/채팅)을 전혀 받을 수 없으므로 입장시키지 않음
+    if (handle == GatewayContext::INVALID_SESSION_HANDLE) {
+        LOG_ERROR("Gateway", "세션 핸들 테이블 고갈 (유저: " << req.account_id() << ") - 접속 거부");
+
+        Protocol::GatewayConnectRes res;
+        res.set_success(false);
+        res.set_reason("Gateway is full");
+        session->Send(Protocol::PKT_GATEWAY_CLIENT_CONNECT_RES, res);
+        session->DisconnectAfterFlush();
+        return;
+    }
+
+    session->SetAccountId(req.account_id());
+    session->SetSessionHandle(handle);
+
+    // 압축 이동 코덱 협상 (서버가 지원하는 것만 허용)
+    uint32_t move_codec = req.move_codec_flags() & MoveCodec::FLAG_COMPACT_MOVE;
+    session->SetMoveCodecFlags(move_codec);
+
     // 핸드셰이크 응답은 평문으로 전송 (암호화 활성화 전)
     Protocol::GatewayConnectRes res;
     res.set_success(true);
+    res.set_move_codec_flags(move_codec);
     session->Send(Protocol::PKT_GATEWAY_CLIENT_CONNECT_RES, res);
 
     //   핸드셰이크 완료 후 암호화 활성화
@@ -64,7 +98,7 @@ void Handle_GatewayConnectReq(std::shared_ptr<ClientSession>& session, char* pay
 }
 
 void Handle_ChatReq(std::shared_ptr<ClientSession>& session, char* payload, uint16_t payloadSize) {
-    Protocol::ChatReq req;
+    auto& req = *PacketArena::Create<Protocol::ChatReq>();
 
     if (!req.ParseFromArray(payload, payloadSize)) {
         LOG_ERROR("Gateway", "ParseFromArray 실패: ChatReq (payloadSize=" << payloadSize << ")");
@@ -77,16 +111,17 @@ void Handle_ChatReq(std::shared_ptr<ClientSession>& session, char* payload, uint
 
     auto& ctx = GatewayContext::Get();
 
-    if (ctx.gameConnection) {
+    if (GameConnection* lane = ctx.GetGameConnection(session->GetAccountId())) {
         Protocol::GatewayGameChatReq s2s_req;
         s2s_req.set_account_id(session->GetAccountId());
         s2s_req.set_msg(req.msg());
-        ctx.gameConnection->Send(Protocol::PKT_GATEWAY_GAME_CHAT_REQ, s2s_req);
+        s2s_req.set_session_handle(session->GetSessionHandle());
+        lane->Send(Protocol::PKT_GATEWAY_GAME_CHAT_REQ, s2s_req);
     }
 }
 
 void Handle_MoveReq(std::shared_ptr<ClientSession>& session, char* payload, uint16_t payloadSize) {
-    Protocol::MoveReq req;
+    auto& req = *PacketArena::Create<Protocol::MoveReq>();
 
     if (!req.ParseFromArray(payload, payloadSize)) {
         LOG_ERROR("Gateway", "ParseFromArray 실패: MoveReq (payloadSize=" << payloadSize << ")");
@@ -98,19 +133,20 @@ void Handle_MoveReq(std::shared_ptr<ClientSession>& session, char* payload, uint
     session->OnParseSuccess();
 
     auto& ctx = GatewayContext::Get();
-    if (ctx.gameConnection) {
+    if (GameConnection* lane = ctx.GetGameConnection(session->GetAccountId())) {
         Protocol::GatewayGameMoveReq s2s_req;
         s2s_req.set_account_id(session->GetAccountId());
         s2s_req.set_x(req.x());
         s2s_req.set_y(req.y());
         s2s_req.set_z(req.z());
         s2s_req.set_yaw(req.yaw());
-        ctx.gameConnection->Send(Protocol::PKT_GATEWAY_GAME_MOVE_REQ, s2s_req);
+        s2s_req.set_session_handle(session->GetSessionHandle());
+        lane->Send(Protocol::PKT_GATEWAY_GAME_MOVE_REQ, s2s_req);
     }
 }
 
 void Handle_AttackReq(std::shared_ptr<ClientSession>& session, char* payload, uint16_t payloadSize) {
-    Protocol::AttackReq req;
+    auto& req = *PacketArena::Create<Protocol::AttackReq>();
 
     if (!req.ParseFromArray(payload, payloadSize)) {
         LOG_ERROR("Gateway", "ParseFromArray 실패: AttackReq (payloadSize=" << payloadSize << ")");
@@ -122,9 +158,10 @@ void Handle_AttackReq(std::shared_ptr<ClientSession>& session, char* payload, ui
     session->OnParseSuccess();
 
     auto& ctx = GatewayContext::Get();
-    if (ctx.gameConnection) {
+    if (GameConnection* lane = ctx.GetGameConnection(session->GetAccountId())) {
         Protocol::GatewayGameAttackReq s2s_req;
         s2s_req.set_account_id(session->GetAccountId());
-        ctx.gameConnection->Send(Protocol::PKT_GATEWAY_GAME_ATTACK_REQ, s2s_req);
+        s2s_req.set_session_handle(session->GetSessionHandle());
+        lane->Send(Protocol::PKT_GATEWAY_GAME_ATTACK_REQ, s2s_req);
     }
 }
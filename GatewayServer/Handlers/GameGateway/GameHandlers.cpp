@@ -7,9 +7,20 @@
 
 #include <iostream>
 #include <mutex>
+#include <functional>
 
+// ==========================================
+//   팬아웃 응답 처리 공통 사항
+//
+// 변경 전: 수신자마다 ClientSession::Send(pktId, msg) -> 같은 메시지를 K번 직렬화
+// 변경 후: MakeSharedPacket()으로 1회 직렬화한 불변 버퍼를 K개 세션이 공유
+//   -> 세션별 작업은 암호화(활성 시)만 남음 (ClientSession::SendShared)
+//
+// 수신자는 target_handles(uint32 세션 핸들)로 지정되며
+// clientMap 문자열 조회 대신 handleTable 인덱스로 세션을 찾음
+// ==========================================
 void Handle_MoveRes_FromGame(std::shared_ptr<GameConnection>& conn, char* payload, uint16_t payloadSize) {
-    Protocol::GameGatewayMoveRes s2s_res;
+    auto& s2s_res = *PacketArena::Create<Protocol::GameGatewayMoveRes>();
 
     //   ParseFromArray 실패 시 로그 출력
     if (!s2s_res.ParseFromArray(payload, payloadSize)) {
@@ -17,25 +28,53 @@ void Handle_MoveRes_FromGame(std::shared_ptr<GameConnection>& conn, char* payloa
         return;
     }
 
-    Protocol::MoveRes client_res;
-    client_res.set_account_id(s2s_res.account_id());
-    client_res.set_x(s2s_res.x());
-    client_res.set_y(s2s_res.y());
-    client_res.set_z(s2s_res.z());
-    client_res.set_yaw(s2s_res.yaw());
+    uint64_t account_hash = std::hash<std::string>{}(s2s_res.account_id());
+
+    // 기존 MoveRes (코덱 미협상 클라이언트 / 엔티티 핸들 없는 이동용), 필요할 때 1회만 직렬화
+    SharedPacket packet;
+    auto get_fallback_packet = [&]() -> const SharedPacket& {
+        if (!packet.IsValid()) {
+            Protocol::MoveRes client_res;
+            client_res.set_account_id(s2s_res.account_id());
+            client_res.set_x(s2s_res.x());
+            client_res.set_y(s2s_res.y());
+            client_res.set_z(s2s_res.z());
+            client_res.set_yaw(s2s_res.yaw());
+            packet = MakeSharedPacket(Protocol::PKT_GATEWAY_CLIENT_MOVE_RES, client_res);
+
+            // 이동 패킷은 같은 엔티티의 최신 위치만 유효 -> 느린 세션의 송신 큐에서 이전 것을 대체
+            // (MOVEMENT 레인은 패킷 ID 테이블로 결정, 0은 "대체 안 함"이므로 최하위 비트를 세워 0을 피함)
+            packet.coalesce_key = account_hash | 1ULL;
+        }
+        return packet;
+    };
 
+    // 압축 코덱 입력 (관찰자별 키프레임/델타 선택은 각 세션 strand에서)
     auto& ctx = GatewayContext::Get();
+    uint32_t mover = ctx.CompactEntityOf(s2s_res.mover_handle());
+    MoveCodec::QuantizedMove qmove = MoveCodec::QuantizedMove::From(s2s_res.x(), s2s_res.y(), s2s_res.z(), s2s_res.yaw());
+    std::shared_ptr<const std::string> account_id;
+
     UTILITY::LockGuard lock(ctx.clientMutex);
-    for (const std::string& target_id : s2s_res.target_account_ids()) {
-        auto it = ctx.clientMap.find(target_id);
-        if (it != ctx.clientMap.end() && it->second) {
-            it->second->Send(Protocol::PKT_GATEWAY_CLIENT_MOVE_RES, client_res);
+    for (uint32_t handle : s2s_res.target_handles()) {
+        ClientSession* target = ctx.FindSessionByHandle(handle);
+        if (!target) continue;
+
+        if (mover != 0 && target->UsesCompactMove()) {
+            if (!account_id) account_id = std::make_shared<const std::string>(s2s_res.account_id());
+            target->SendCompactMove(mover, account_hash, account_id, qmove);
+            continue;
+        }
+
+        const SharedPacket& fallback = get_fallback_packet();
+        if (fallback.IsValid()) {
+            target->SendShared(fallback);
         }
     }
 }
 
 void Handle_GameGatewayAttackRes(std::shared_ptr<GameConnection>& session, char* payload, uint16_t size) {
-    Protocol::GameGatewayAttackRes s2s_res;
+    auto& s2s_res = *PacketArena::Create<Protocol::GameGatewayAttackRes>();
 
     if (!s2s_res.ParseFromArray(payload, size)) {
         LOG_ERROR("Gateway", "ParseFromArray 실패: GameGatewayAttackRes (payloadSize=" << size << ")");
@@ -48,13 +87,15 @@ void Handle_GameGatewayAttackRes(std::shared_ptr<GameConnection>& session, char*
     client_res.set_damage(s2s_res.damage());
     client_res.set_target_remain_hp(s2s_res.target_remain_hp());
 
+    SharedPacket packet = MakeSharedPacket(Protocol::PKT_GATEWAY_CLIENT_ATTACK_RES, client_res);
+    if (!packet.IsValid()) return;
+
     auto& ctx = GatewayContext::Get();
     UTILITY::LockGuard lock(ctx.clientMutex);
-    for (int i = 0; i < s2s_res.target_account_ids_size(); ++i) {
-        const std::string& target_id = s2s_res.target_account_ids(i);
-        auto it = ctx.clientMap.find(target_id);
-        if (it != ctx.clientMap.end() && it->second) {
-            it->second->Send(Protocol::PKT_GATEWAY_CLIENT_ATTACK_RES, client_res);
+    for (uint32_t handle : s2s_res.target_handles()) {
+        ClientSession* target = ctx.FindSessionByHandle(handle);
+        if (target) {
+            target->SendShared(packet);
         }
     }
 }
@@ -67,7 +108,7 @@ void Handle_GameGatewayAttackRes(std::shared_ptr<GameConnection>& session, char*
 // 이후 클라이언트가 GatewayConnectReq를 보내면 이 토큰으로 검증합니다.
 // ==========================================
 void Handle_TokenNotify_FromGame(std::shared_ptr<GameConnection>& conn, char* payload, uint16_t payloadSize) {
-    Protocol::TokenNotify notify;
+    auto& notify = *PacketArena::Create<Protocol::TokenNotify>();
     if (!notify.ParseFromArray(payload, payloadSize)) {
         LOG_ERROR("Gateway", "ParseFromArray 실패: TokenNotify (payloadSize=" << payloadSize << ")");
         return;
@@ -87,7 +128,7 @@ void Handle_TokenNotify_FromGame(std::shared_ptr<GameConnection>& conn, char* pa
 //          해당 유저들에게만 채팅을 전달 (O(K), K = AOI 내 유저 수)
 // ==========================================
 void Handle_ChatRes_FromGame(std::shared_ptr<GameConnection>& conn, char* payload, uint16_t payloadSize) {
-    Protocol::GameGatewayChatRes s2s_res;
+    auto& s2s_res = *PacketArena::Create<Protocol::GameGatewayChatRes>();
     if (!s2s_res.ParseFromArray(payload, payloadSize)) {
         LOG_ERROR("Gateway", "ParseFromArray 실패: GameGatewayChatRes (payloadSize=" << payloadSize << ")");
         return;
@@ -97,14 +138,37 @@ void Handle_ChatRes_FromGame(std::shared_ptr<GameConnection>& conn, char* payloa
     client_res.set_account_id(s2s_res.account_id());
     client_res.set_msg(s2s_res.msg());
 
+    SharedPacket packet = MakeSharedPacket(Protocol::PKT_GATEWAY_CLIENT_CHAT_RES, client_res);
+    if (!packet.IsValid()) {
+        LOG_ERROR("Gateway", "ChatRes 패킷 크기 초과 - 전송 취소 (유저: " << s2s_res.account_id() << ")");
+        return;
+    }
+
     auto& ctx = GatewayContext::Get();
     UTILITY::LockGuard lock(ctx.clientMutex);
 
-    for (int i = 0; i < s2s_res.target_account_ids_size(); ++i) {
-        const std::string& target_id = s2s_res.target_account_ids(i);
-        auto it = ctx.clientMap.find(target_id);
-        if (it != ctx.clientMap.end() && it->second) {
-            it->second->Send(Protocol::PKT_GATEWAY_CLIENT_CHAT_RES, client_res);
+    for (uint32_t handle : s2s_res.target_handles()) {
+        ClientSession* target = ctx.FindSessionByHandle(handle);
+        if (target) {
+            target->SendShared(packet);
         }
     }
 }
+
+// ==========================================
+//   GameServer로부터 레인 Hello 응답 수신
+//
+// GameServer가 양쪽 모두 지원하는 압축 코덱만 남겨 돌려주면
+// 이 레인의 이후 번들부터 압축을 적용합니다. (재연결 시 다시 협상)
+// ==========================================
+void Handle_LaneHelloAck_FromGame(std::shared_ptr<GameConnection>& conn, char* payload, uint16_t payloadSize) {
+    auto& ack = *PacketArena::Create<Protocol::GameGatewayLaneHelloAck>();
+    if (!ack.ParseFromArray(payload, payloadSize)) {
+        LOG_ERROR("Gateway", "ParseFromArray 실패: GameGatewayLaneHelloAck (payloadSize=" << payloadSize << ")");
+        return;
+    }
+
+    uint32_t flags = ack.compression_flags() & S2SCompression::SupportedFlags();
+    conn->SetCompressionFlags(flags);
+    LOG_INFO("Gateway", "S2S 레인 협상 완료 (압축: " << ((flags & S2SCompression::FLAG_LZ4) ? "LZ4" : "OFF") << ")");
+}
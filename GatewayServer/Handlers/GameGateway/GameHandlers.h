@@ -12,3 +12,6 @@ void Handle_TokenNotify_FromGame(std::shared_ptr<GameConnection>& conn, char* pa
 
 //   GameServer로부터 채팅 AOI 응답 수신
 void Handle_ChatRes_FromGame(std::shared_ptr<GameConnection>& conn, char* payload, uint16_t payloadSize);
+
+//   GameServer로부터 레인 Hello 응답 수신 (S2S 압축 협상)
+void Handle_LaneHelloAck_FromGame(std::shared_ptr<GameConnection>& conn, char* payload, uint16_t payloadSize);
@@ -5,13 +5,26 @@
 
 using boost::asio::ip::tcp;
 
-GameConnection::GameConnection(boost::asio::io_context& io_context)
+GameConnection::GameConnection(boost::asio::io_context& io_context, uint32_t lane_index, uint32_t lane_count)
     : socket_(io_context)
     , io_context_(io_context)
     , retry_timer_(io_context)
     , strand_(io_context)   // strand_ 초기화 추가
+    , bundle_(static_cast<uint16_t>(Protocol::PKT_S2S_BUNDLE))
+    , lane_index_(lane_index)
+    , lane_count_(lane_count)
 {}
 
+// 연결(재연결) 직후 가장 먼저 전송: GameServer가 이 레인의 소속 Gateway와 대표 레인 여부를 판단
+void GameConnection::SendLaneHello() {
+    Protocol::GatewayGameLaneHello hello;
+    hello.set_gateway_id(GatewayContext::Get().gatewayId);
+    hello.set_lane_index(lane_index_);
+    hello.set_lane_count(lane_count_);
+    hello.set_compression_flags(S2SCompression::SupportedFlags());
+    Send(Protocol::PKT_GATEWAY_GAME_LANE_HELLO, hello);
+}
+
 void GameConnection::Connect(const std::string& ip, short port) {
     target_ip_ = ip;
     target_port_ = port;
@@ -33,34 +46,92 @@ void GameConnection::Send(uint16_t pktId, const google::protobuf::Message& msg)
         return;
     }
 
-    auto send_buf = std::make_shared<std::vector<char>>(totalSize);
+    SendBuffer* raw_buf = SendBufferPool::GetInstance().Acquire(totalSize);
+    std::shared_ptr<SendBuffer> send_buf(raw_buf, SendBufferDeleter());
+
     PacketHeader header{ totalSize, pktId };
-    memcpy(send_buf->data(), &header, sizeof(PacketHeader));
-    msg.SerializeToArray(send_buf->data() + sizeof(PacketHeader), payloadSize);
+    memcpy(send_buf->Data(), &header, sizeof(PacketHeader));
+    msg.SerializeToArray(send_buf->Data() + sizeof(PacketHeader), payloadSize);
 
     auto self(shared_from_this());
 
     boost::asio::post(strand_, [this, self, send_buf, totalSize]() {
-        bool write_in_progress = !send_queue_.empty();
-        send_queue_.emplace_back(send_buf, static_cast<size_t>(totalSize));
-        if (!write_in_progress) DoWrite();
+        EnqueueFrame(send_buf, totalSize);
     });
 }
 
+// ==========================================
+//   EnqueueFrame / FlushBundle - S2S 번들 전송
+//
+// 변경 전: Send() 1회 = 송신 큐 엔트리 1개 = S2S 프레임 1개
+// 변경 후: strand 턴 동안 들어온 프레임을 번들 1개로 묶은 뒤 송신 큐에 넣음
+//   -> 첫 프레임이 들어올 때 strand에 플러시를 예약, 그 전까지 들어온 프레임은 같은 번들로
+//   -> 누적 크기가 S2S_BUNDLE_FLUSH_BYTES를 넘거나 자리가 없으면 즉시 플러시
+// ==========================================
+void GameConnection::EnqueueFrame(std::shared_ptr<SendBuffer> frame, uint16_t frame_size) {
+    if (!bundle_.Fits(frame_size)) FlushBundle();
+
+    bundle_.Append(frame, frame_size);
+
+    if (bundle_.Bytes() >= GameConstants::Network::S2S_BUNDLE_FLUSH_BYTES) {
+        FlushBundle();
+        return;
+    }
+
+    if (!bundle_flush_scheduled_) {
+        bundle_flush_scheduled_ = true;
+        auto self(shared_from_this());
+        boost::asio::post(strand_, [this, self]() {
+            bundle_flush_scheduled_ = false;
+            FlushBundle();
+        });
+    }
+}
+
+void GameConnection::FlushBundle() {
+    if (bundle_.Empty()) return;
+
+    S2SBundleWriter::Flushed flushed = bundle_.Take();
+
+    // 협상된 링크에서 일정 크기 이상의 번들만 압축 (이득이 없으면 원본 유지)
+    if (flushed.count > 1 && flushed.size >= GameConstants::Network::S2S_COMPRESS_MIN_BYTES &&
+        (compression_flags_.load(std::memory_order_relaxed) & S2SCompression::FLAG_LZ4)) {
+        uint16_t compressed_size = 0;
+        auto compressed = S2SCompression::CompressFrame(flushed.buffer->Data(), flushed.size,
+            static_cast<uint16_t>(Protocol::PKT_S2S_BUNDLE_LZ4), compressed_size);
+        if (compressed) {
+            flushed.buffer = std::move(compressed);
+            flushed.size = compressed_size;
+        }
+    }
+
+    bool write_in_progress = !send_queue_.Empty();
+    PushResult result = send_queue_.Push(std::move(flushed.buffer), static_cast<size_t>(flushed.size));
+    if (IsQueued(result) && !write_in_progress) DoWrite();
+}
+
+// gather write (SendQueue::PrepareBatch 참고)
 void GameConnection::DoWrite() {
     auto self(shared_from_this());
-    auto& front = send_queue_.front();
+
+    // 무효화 엔트리만 실린 배치 -> 빈 async_write 없이 즉시 정리 (SendQueue::PrepareBatch 참고)
+    auto batch = send_queue_.PrepareBatch();
+    if (batch.empty()) {
+        send_queue_.FinishBatch(true);
+        return;
+    }
 
     boost::asio::async_write(socket_,
-        boost::asio::buffer(front.first->data(), front.second),
+        batch,
         boost::asio::bind_executor(strand_, [this, self](boost::system::error_code ec, std::size_t) {
             if (!ec) {
-                send_queue_.pop_front();
-                if (!send_queue_.empty()) DoWrite();
+                send_queue_.FinishBatch(true);
+                if (!send_queue_.Empty()) DoWrite();
             }
             else {
                 std::cerr << "[Gateway] GameServer로 S2S 패킷 전송 실패 (DoWrite): " << ec.message() << "\n";
-                send_queue_.clear();
+                send_queue_.FinishBatch(false);
+                send_queue_.Clear();
                 ScheduleRetry();
             }
         }));
@@ -75,7 +146,13 @@ void GameConnection::DoConnect() {
         boost::asio::async_connect(socket_, endpoints,
             [this, self](boost::system::error_code ec, tcp::endpoint) {
                 if (!ec) {
-                    std::cout << "[Gateway] 🕹️ GameServer(S2S) 9000번 포트에 성공적으로 연결되었습니다!\n";
+                    // S2S는 이미 번들 단위로 묶어서 보내므로 Nagle 지연을 끔
+                    boost::system::error_code opt_ec;
+                    socket_.set_option(tcp::no_delay(true), opt_ec);
+
+                    std::cout << "[Gateway] 🕹️ GameServer(S2S) 9000번 포트에 성공적으로 연결되었습니다! (레인 "
+                        << lane_index_ << "/" << lane_count_ << ")\n";
+                    SendLaneHello();
                     ReadHeader();
                 }
                 else {
@@ -104,11 +181,13 @@ void GameConnection::DoConnect() {
 // ==========================================
 void GameConnection::ScheduleRetry() {
     // 전송 큐 초기화 (이전 연결의 잔여 패킷 제거)
-    boost::asio::post(strand_, [this]() { send_queue_.clear(); });
+    //   -> 전송 중인 배치는 DoWrite 완료 콜백에서 정리됨
+    boost::asio::post(strand_, [this]() { send_queue_.Clear(); bundle_.Clear(); });
 
     //   수신 상태 초기화 — 이전 연결의 잔여 데이터 제거
     std::memset(&header_, 0, sizeof(PacketHeader));
     payload_buf_.clear();
+    compression_flags_.store(0, std::memory_order_relaxed);
 
     if (socket_.is_open()) {
         boost::system::error_code ec;
@@ -165,7 +244,29 @@ void GameConnection::ReadPayload(uint16_t payload_size) {
         [this, self, payload_size](boost::system::error_code ec, std::size_t length) {
             if (!ec) {
                 auto session_ptr = self;
-                GatewayContext::Get().gameDispatcher.Dispatch(session_ptr, header_.id, payload_buf_.data(), payload_size);
+                auto& dispatcher = GatewayContext::Get().gameDispatcher;
+                PacketArena::BatchScope arena_scope;    // 번들 1개분 파싱 결과를 끝에서 일괄 회수
+
+                // 번들 프레임은 서브 메시지를 순서대로 꺼내 각각 Dispatch
+                auto dispatch_sub = [&](uint16_t id, char* data, uint16_t size) {
+                    dispatcher.Dispatch(session_ptr, id, data, size);
+                };
+
+                if (header_.id == Protocol::PKT_S2S_BUNDLE) {
+                    if (!ForEachBundled(payload_buf_.data(), payload_size, dispatch_sub)) {
+                        std::cerr << "🚨 [Gateway] 손상된 S2S 번들 수신 (size: " << payload_size << ")\n";
+                    }
+                }
+                else if (header_.id == Protocol::PKT_S2S_BUNDLE_LZ4) {
+                    char raw[MAX_PACKET_SIZE];
+                    int raw_size = S2SCompression::DecompressPayload(payload_buf_.data(), payload_size, raw, sizeof(raw));
+                    if (raw_size < 0 || !ForEachBundled(raw, static_cast<uint16_t>(raw_size), dispatch_sub)) {
+                        std::cerr << "🚨 [Gateway] 압축 S2S 번들 복원 실패 (size: " << payload_size << ")\n";
+                    }
+                }
+                else {
+                    dispatcher.Dispatch(session_ptr, header_.id, payload_buf_.data(), payload_size);
+                }
                 ReadHeader();
             }
             else {
@@ -7,6 +7,10 @@
 #include <utility>
 #include <google/protobuf/message.h>
 #include "../GatewayServer.h"
+#include "../../Common/Network/SendQueue.h"
+#include "../../Common/Network/S2SBundle.h"
+#include "../../Common/Network/S2SCompression.h"
+#include <atomic>
 
 class GameConnection : public std::enable_shared_from_this<GameConnection> {
 private:
@@ -24,26 +28,46 @@ private:
     //
     // 변경 후: GatewaySession, ClientSession과 동일한 strand + deque 패턴 적용
     //   → 모든 Send() 호출이 strand_ 내부에서 직렬화되어 안전하게 전송됨
+    //
+    // 송신 버퍼를 make_shared<vector<char>> -> SendBufferPool 대여로 변경
+    //   → 다른 세션과 같은 SendQueue(gather write)를 공유하기 위함
     // ==========================================
     boost::asio::io_context::strand strand_;
-    std::deque<std::pair<std::shared_ptr<std::vector<char>>, size_t>> send_queue_;
+    SendQueue send_queue_;
+
+    //   S2S 번들: 같은 strand 턴에 쌓인 요청을 프레임 1개로 묶어서 전송 (strand_ 전용)
+    S2SBundleWriter bundle_;
+    bool bundle_flush_scheduled_ = false;
+
+    //   협상된 S2S 압축 코덱 (LaneHelloAck 수신 시 설정, 재연결 시 0으로 초기화)
+    std::atomic<uint32_t> compression_flags_{ 0 };
 
     PacketHeader header_;
     std::vector<char> payload_buf_;
     std::string target_ip_;
     short target_port_;
 
+    // S2S 레인 식별 (연결될 때마다 GatewayGameLaneHello로 GameServer에 통지)
+    uint32_t lane_index_ = 0;
+    uint32_t lane_count_ = 1;
+
 public:
-    GameConnection(boost::asio::io_context& io_context);
+    GameConnection(boost::asio::io_context& io_context, uint32_t lane_index = 0, uint32_t lane_count = 1);
     void Connect(const std::string& ip, short port);
     void Send(uint16_t pktId, const google::protobuf::Message& msg);
+    void SetCompressionFlags(uint32_t flags) { compression_flags_.store(flags, std::memory_order_relaxed); }
 
 private:
     void DoConnect();
+    void SendLaneHello();
     void ScheduleRetry();
     void ReadHeader();
     void ReadPayload(uint16_t payload_size);
 
-    // 큐에서 패킷을 꺼내 실제로 전송하는 내부 함수
+    // 프레임을 번들에 추가하고 필요 시 플러시 예약 (strand_ 안에서만 호출)
+    void EnqueueFrame(std::shared_ptr<SendBuffer> frame, uint16_t frame_size);
+    void FlushBundle();
+
+    // 큐에 쌓인 패킷을 묶어서 실제로 전송하는 내부 함수
     void DoWrite();
 };
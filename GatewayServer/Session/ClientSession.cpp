@@ -5,14 +5,84 @@
 #include "..\Common\MemoryPool.h"
 #include "..\Common\Utils\NetworkErrorHandler.h"
 #include "..\Common\Utils\Logger.h"
+#include "..\Common\Network\TimingWheel.h"
 #include <iostream>
+#include <array>
 
 ClientSession::ClientSession(boost::asio::ip::tcp::socket socket) noexcept
     : socket_(std::move(socket))
     , strand_(static_cast<boost::asio::io_context&>(socket_.get_executor().context()))
-{}
+{
+    send_queue_.SetByteBudget(GameConstants::Network::CLIENT_SEND_SOFT_BUDGET,
+                              GameConstants::Network::CLIENT_SEND_HARD_BUDGET);
+}
+
+// ==========================================
+//   패킷 ID별 송신 우선순위 테이블
+//
+// Send/SendShared/EnqueuePayload 모든 경로가 이 테이블로 레인을 결정
+//   -> 미등록 ID는 CONTROL (보수적으로 최우선 + 드랍 불가)
+//   -> 이동 키프레임은 드랍 불가이면서 전투보다 급하지 않으므로 CHAT 레인
+//      (이후 델타의 기준값이므로 델타가 쌓인 MOVEMENT 레인보다는 먼저 나가야 함)
+// ==========================================
+static constexpr size_t CLIENT_SEND_CLASS_TABLE_SIZE = 64;
+
+static const std::array<SendClass, CLIENT_SEND_CLASS_TABLE_SIZE> s_client_send_class = [] {
+    std::array<SendClass, CLIENT_SEND_CLASS_TABLE_SIZE> table;
+    table.fill(SendClass::CONTROL);
+    table[Protocol::PKT_GATEWAY_CLIENT_CONNECT_RES]   = SendClass::CONTROL;
+    table[Protocol::PKT_GATEWAY_CLIENT_ATTACK_RES]    = SendClass::COMBAT;
+    table[Protocol::PKT_GATEWAY_CLIENT_CHAT_RES]      = SendClass::CHAT;
+    table[Protocol::PKT_GATEWAY_CLIENT_MOVE_KEYFRAME] = SendClass::CHAT;
+    table[Protocol::PKT_GATEWAY_CLIENT_MOVE_RES]      = SendClass::MOVEMENT;
+    table[Protocol::PKT_GATEWAY_CLIENT_MOVE_DELTA]    = SendClass::MOVEMENT;
+    return table;
+}();
+
+static SendClass ClassifyClientPacket(uint16_t pktId) {
+    if (pktId >= CLIENT_SEND_CLASS_TABLE_SIZE) return SendClass::CONTROL;
+    return s_client_send_class[pktId];
+}
+
+void ClientSession::start() {
+    last_recv_.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+    DoRead();
+    StartIdleCheck();
+}
+
+// ==========================================
+//   유휴 검사 - 휠은 weak_ptr만 보유 (종료된 세션의 수명을 늘리지 않음)
+// ==========================================
+void ClientSession::StartIdleCheck() {
+    std::weak_ptr<ClientSession> weak = shared_from_this();
+    TimingWheel::GetInstance().Schedule(
+        std::chrono::seconds(GameConstants::Network::CLIENT_IDLE_CHECK_SEC),
+        [weak]() {
+            auto self = weak.lock();
+            if (!self) return;
+            boost::asio::post(self->strand_, [self]() { self->OnIdleCheck(); });
+        });
+}
+
+void ClientSession::OnIdleCheck() {
+    if (disconnected_.load(std::memory_order_acquire) || !socket_.is_open()) return;
+
+    auto last = std::chrono::steady_clock::time_point(
+        std::chrono::steady_clock::duration(last_recv_.load(std::memory_order_relaxed)));
+    auto idle_sec = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::steady_clock::now() - last).count();
+
+    if (idle_sec > GameConstants::Network::CLIENT_IDLE_TIMEOUT_SEC) {
+        LOG_WARN("Gateway", "유휴 연결 종료 (유저: " << account_id_ << ", " << idle_sec << "초 동안 수신 없음)");
+        send_queue_.Clear();
+        boost::system::error_code ec;
+        socket_.close(ec);     // 진행 중인 DoRead는 operation_aborted(무시)로 종료됨
+        OnDisconnected();
+        return;
+    }
 
-void ClientSession::start() { ReadHeader(); }
+    StartIdleCheck();
+}
 
 void ClientSession::SetAccountId(const std::string& id) { account_id_ = id; }
 const std::string& ClientSession::GetAccountId() const { return account_id_; }
@@ -23,7 +93,7 @@ const std::string& ClientSession::GetAccountId() const { return account_id_; }
 // GatewayConnectReq/Res 핸드셰이크가 성공한 뒤 호출됩니다.
 // 사전 공유 패스프레이즈에서 AES-128 키를 도출하고 암호화를 활성화합니다.
 //
-// 이 메서드 호출 이후의 모든 Send/ReadPayload는 암호화된 페이로드를 처리합니다.
+// 이 메서드 호출 이후의 모든 Send/ProcessFrames는 암호화된 페이로드를 처리합니다.
 // GatewayConnectRes는 핸드셰이크 패킷이므로 평문으로 전송된 뒤 활성화됩니다.
 // ==========================================
 void ClientSession::EnableEncryption() {
@@ -54,11 +124,24 @@ void ClientSession::OnParseSuccess() {
 }
 
 // ==========================================
-//   Send() - 암호화 통합
+//   Send() - 암호화 통합 + 제로 카피 송신 경로
+//
+// 변경 전: SerializeToString(std::string) -> Encrypt(std::vector 할당)
+//   -> SendBuffer로 memcpy (패킷당 힙 할당 3회, 복사 3회)
+//
+// 변경 후: 최종 크기를 먼저 계산하고 풀 버퍼 하나에 바로 직렬화
+//   -> 평문 세션: [PacketHeader][Payload]를 그대로 적재
+//   -> 암호화 세션: 평문 프레임을 "봉인 지연" 엔트리로 적재하고,
+//      DoWrite의 PrepareBatch()가 배치에 싣는 순간 SealEntry()로 암호화
 //
-// 변경 전: Protobuf 직렬화 → 평문 페이로드를 그대로 전송
-// 변경 후: Protobuf 직렬화 → 암호화(활성 시) → 암호화된 페이로드 전송
-//   PacketHeader.size에는 암호화 오버헤드(SeqNum+IV+padding)가 포함됨
+// 암호화를 적재 시점이 아니라 전송 배치 시점에 수행하는 이유:
+//   send_queue_가 우선순위 레인으로 나뉘어 적재 순서 ≠ 전송 순서
+//   -> 시퀀스 번호를 전송 순서대로 발급해야 수신 측 ValidateSequence에서
+//      리플레이로 오판되지 않음
+//   -> 대체/드랍된 이동 패킷은 암호화 비용 자체가 발생하지 않음
+//
+// 암호화 여부는 호출 시점에 결정 (핸드셰이크 응답은 EnableEncryption 전에 평문으로 나감)
+// 빈 페이로드는 수신 측(ProcessFrames)과 동일하게 평문으로 전송
 // ==========================================
 void ClientSession::Send(uint16_t pktId, const google::protobuf::Message& msg) {
     if (!socket_.is_open()) {
@@ -66,75 +149,246 @@ void ClientSession::Send(uint16_t pktId, const google::protobuf::Message& msg) {
         return;
     }
 
-    // 1. Protobuf 직렬화
-    std::string serialized;
-    msg.SerializeToString(&serialized);
+    size_t payload_size = msg.ByteSizeLong();
+    bool encrypt = crypto_enabled_ && crypto_.IsInitialized() && payload_size > 0;
 
-    // 2. 암호화 (활성화된 경우)
-    std::vector<char> final_payload;
-    if (crypto_enabled_ && crypto_.IsInitialized()) {
-        auto result = crypto_.Encrypt(serialized.data(), static_cast<uint16_t>(serialized.size()));
-        if (result.success) {
-            final_payload = std::move(result.data);
-        }
-        else {
-            LOG_ERROR("Gateway", "패킷 암호화 실패 (PktID: " << pktId << ") - " << result.error_message);
-            return;
-        }
+    size_t wire_payload = encrypt ? CryptoConstants::GetEncryptedSize(payload_size) : payload_size;
+    size_t wire_size = sizeof(PacketHeader) + wire_payload;
+    if (wire_size > MAX_PACKET_SIZE) {
+        LOG_ERROR("Gateway", "패킷 크기 초과! (PktID: " << pktId << ", Size: " << wire_size << " bytes) - 전송 취소");
+        return;
     }
-    else {
-        final_payload.assign(serialized.begin(), serialized.end());
+
+    size_t plain_size = sizeof(PacketHeader) + payload_size;
+    SendBuffer* raw_buf = SendBufferPool::GetInstance().Acquire(plain_size);
+    std::shared_ptr<SendBuffer> send_buf(raw_buf, SendBufferDeleter());
+
+    PacketHeader header{ static_cast<uint16_t>(plain_size), pktId };
+    memcpy(send_buf->Data(), &header, sizeof(PacketHeader));
+    msg.SerializeToArray(send_buf->Data() + sizeof(PacketHeader), static_cast<int>(payload_size));
+
+    auto self(shared_from_this());
+    SendClass send_class = ClassifyClientPacket(pktId);
+    uint16_t totalSize = static_cast<uint16_t>(wire_size);
+
+    boost::asio::post(strand_, [this, self, send_buf, totalSize, send_class, encrypt]() {
+        EnqueueSend(send_buf, totalSize, send_class, 0, encrypt);
+    });
+}
+
+// ==========================================
+//   SendShared() - 직렬화 1회 팬아웃 전송
+//
+// 팬아웃 핸들러(MoveRes/AttackRes/ChatRes)는 MakeSharedPacket()으로 1회만 직렬화한 뒤
+// 수신자마다 SendShared()를 호출합니다.
+//   - 암호화 비활성: 공유 버퍼를 그대로 send_queue_에 넣음 (복사 0회)
+//   - 암호화 활성:   공유 평문 버퍼를 봉인 지연 엔트리로 넣고, 전송 배치에 실릴 때
+//                    이 세션 전용 풀 버퍼에 바로 암호화 (SealEntry, 중간 버퍼 없음)
+// 송신 레인은 packet.id로 테이블에서 결정 (coalesce_key만 호출 측이 지정)
+// ==========================================
+void ClientSession::SendShared(const SharedPacket& packet) {
+    if (!socket_.is_open()) {
+        LOG_WARN("Gateway", "Send 시도했으나 소켓이 이미 닫혀있음 (PktID: " << packet.id << ")");
+        return;
     }
 
-    // 3. 패킷 헤더 구성 (암호화 오버헤드 포함)
-    uint16_t totalSize = static_cast<uint16_t>(sizeof(PacketHeader) + final_payload.size());
+    auto self(shared_from_this());
+    bool encrypt = crypto_enabled_ && crypto_.IsInitialized() && packet.PayloadSize() > 0;
 
-    if (totalSize > MAX_PACKET_SIZE) {
-        LOG_ERROR("Gateway", "패킷 크기 초과! (PktID: " << pktId << ", Size: " << totalSize << " bytes) - 전송 취소");
+    size_t wire_size = encrypt
+        ? sizeof(PacketHeader) + CryptoConstants::GetEncryptedSize(packet.PayloadSize())
+        : packet.size;
+    if (wire_size > MAX_PACKET_SIZE) {
+        LOG_ERROR("Gateway", "패킷 크기 초과! (PktID: " << packet.id << ", Size: " << wire_size << " bytes) - 전송 취소");
         return;
     }
 
-    SendBuffer* raw_buf = SendBufferPool::GetInstance().Acquire();
-    std::shared_ptr<SendBuffer> send_buf(raw_buf, SendBufferDeleter());
+    std::shared_ptr<SendBuffer> send_buf = packet.buffer;
+    uint16_t totalSize = static_cast<uint16_t>(wire_size);
+    SendClass send_class = ClassifyClientPacket(packet.id);
+    uint64_t coalesce_key = packet.coalesce_key;
+    boost::asio::post(strand_, [this, self, send_buf, totalSize, send_class, coalesce_key, encrypt]() {
+        EnqueueSend(send_buf, totalSize, send_class, coalesce_key, encrypt);
+    });
+}
 
-    PacketHeader header{ totalSize, pktId };
-    memcpy(send_buf->buffer_.data(), &header, sizeof(PacketHeader));
-    memcpy(send_buf->buffer_.data() + sizeof(PacketHeader), final_payload.data(), final_payload.size());
+// ==========================================
+//   SendCompactMove() - 관찰자별 압축 이동 인코딩
+//
+// 키프레임/델타 선택은 이 세션이 이전에 보낸 기준값에 따라 달라지므로
+// 공유 버퍼를 쓸 수 없고, strand 안에서 인코딩과 적재를 한 번에 수행합니다.
+// (인코딩 후 다시 post하면 뒤따르는 델타가 키프레임보다 먼저 적재될 수 있음)
+//   - 키프레임: CHAT 레인 (드랍/대체 금지, 이후 델타의 기준값)
+//               같은 키로 적재하여 아직 대기 중인 이전 기준의 델타를 무효화
+//   - 델타:     MOVEMENT (같은 엔티티의 이전 델타를 대체, soft 예산 초과 시 드랍)
+// ==========================================
+void ClientSession::SendCompactMove(uint32_t entity, uint64_t account_hash,
+                                    const std::shared_ptr<const std::string>& account_id,
+                                    const MoveCodec::QuantizedMove& move) {
+    if (!socket_.is_open()) return;
 
     auto self(shared_from_this());
+    boost::asio::post(strand_, [this, self, entity, account_hash, account_id, move]() {
+        MoveCodec::ObserverEncoder::Result result = move_encoder_.Encode(entity, account_hash, move);
 
-    boost::asio::post(strand_, [this, self, send_buf, totalSize]() {
-        if (send_queue_.size() > GameConstants::Network::SEND_QUEUE_MAX_SIZE) {
-            LOG_WARN("Gateway", "ClientSession Send Queue 폭발! 전송 드랍.");
+        if (result.kind == MoveCodec::ObserverEncoder::Kind::DELTA) {
+            char delta[MoveCodec::MAX_DELTA_PAYLOAD];
+            size_t size = MoveCodec::EncodeDelta(delta, entity, result.dx, result.dy, result.dz, move.yaw);
+            EnqueuePayload(Protocol::PKT_GATEWAY_CLIENT_MOVE_DELTA, delta, static_cast<uint16_t>(size),
+                account_hash | 1ULL);
             return;
         }
 
-        bool write_in_progress = !send_queue_.empty();
-        send_queue_.emplace_back(send_buf, static_cast<size_t>(totalSize));
+        Protocol::MoveKeyframe key;
+        key.set_entity(entity);
+        if (result.include_account_id) key.set_account_id(*account_id);
+        key.set_qx(move.qx);
+        key.set_qy(move.qy);
+        key.set_qz(move.qz);
+        key.set_yaw(move.yaw);
 
-        if (!write_in_progress) {
-            DoWrite();
-        }
+        char plain[MAX_PACKET_SIZE];
+        size_t size = key.ByteSizeLong();
+        if (size > sizeof(plain)) return;
+        key.SerializeToArray(plain, static_cast<int>(size));
+        EnqueuePayload(Protocol::PKT_GATEWAY_CLIENT_MOVE_KEYFRAME, plain, static_cast<uint16_t>(size),
+            account_hash | 1ULL);
     });
 }
 
+// ==========================================
+//   EnqueuePayload - strand 안에서 만든 평문 페이로드 적재 (세션별 인코딩 경로)
+// ==========================================
+void ClientSession::EnqueuePayload(uint16_t pktId, const char* payload, uint16_t payload_size,
+                                   uint64_t coalesce_key) {
+    bool encrypt = crypto_enabled_ && crypto_.IsInitialized() && payload_size > 0;
+    size_t wire_size = sizeof(PacketHeader) +
+        (encrypt ? CryptoConstants::GetEncryptedSize(payload_size) : payload_size);
+    if (wire_size > MAX_PACKET_SIZE) {
+        LOG_ERROR("Gateway", "패킷 크기 초과! (PktID: " << pktId << ", Size: " << wire_size << " bytes) - 전송 취소");
+        return;
+    }
+
+    size_t plain_size = sizeof(PacketHeader) + payload_size;
+    SendBuffer* raw_buf = SendBufferPool::GetInstance().Acquire(plain_size);
+    std::shared_ptr<SendBuffer> send_buf(raw_buf, SendBufferDeleter());
+    char* base = send_buf->Data();
+
+    PacketHeader header{ static_cast<uint16_t>(plain_size), pktId };
+    memcpy(base, &header, sizeof(PacketHeader));
+    if (payload_size > 0) {
+        memcpy(base + sizeof(PacketHeader), payload, payload_size);
+    }
+
+    EnqueueSend(send_buf, static_cast<uint16_t>(wire_size), ClassifyClientPacket(pktId), coalesce_key, encrypt);
+}
+
+// ==========================================
+//   SealEntry - 봉인 지연 엔트리 암호화 (PrepareBatch 콜백, strand 내부 전용)
+//
+// entry.buffer의 평문 프레임 [PacketHeader][Payload]를 이 세션 전용 풀 버퍼에
+// [PacketHeader][SeqNum][IV][CipherText]로 암호화하여 교체합니다.
+// 호출 순서가 곧 전송 순서이므로 시퀀스 번호가 전송 순서대로 발급됩니다.
+// ==========================================
+bool ClientSession::SealEntry(SendQueue::Entry& entry) {
+    const char* plain = entry.buffer->Data();
+    PacketHeader plain_header;
+    memcpy(&plain_header, plain, sizeof(PacketHeader));
+    uint16_t payload_size = static_cast<uint16_t>(plain_header.size - sizeof(PacketHeader));
+
+    SendBuffer* raw_buf = SendBufferPool::GetInstance().Acquire(entry.size);
+    std::shared_ptr<SendBuffer> send_buf(raw_buf, SendBufferDeleter());
+    char* base = send_buf->Data();
+
+    size_t written = crypto_.EncryptInto(plain + sizeof(PacketHeader), payload_size,
+        base + sizeof(PacketHeader), send_buf->Capacity() - sizeof(PacketHeader));
+    if (written == 0) {
+        LOG_ERROR("Gateway", "패킷 암호화 실패 (PktID: " << plain_header.id << ")");
+        return false;
+    }
+
+    uint16_t totalSize = static_cast<uint16_t>(sizeof(PacketHeader) + written);
+    PacketHeader header{ totalSize, plain_header.id };
+    memcpy(base, &header, sizeof(PacketHeader));
+
+    entry.buffer = std::move(send_buf);
+    entry.size = totalSize;
+    return true;
+}
+
+// ==========================================
+//   EnqueueSend - 바이트 예산 기반 적재 (strand 내부 전용)
+//
+// 변경 전: 개수 상한(SEND_QUEUE_MAX_SIZE) 초과 시 무엇이든 드랍
+// 변경 후: SendQueue의 클래스별 정책 결과에 따라 처리
+//   - DROPPED:     이동 패킷만 버려짐 (다음 이동으로 자연 복구), 주기적으로 경고
+//   - OVER_BUDGET: 전투/채팅까지 hard 예산을 넘긴 소비 불능 클라이언트 -> 연결 종료
+//     (수신 완료도 strand_에서 실행되므로 종료 처리는 OnDisconnected 1회로 수렴)
+// 종료된 세션에 뒤늦게 도착한 송신은 닫힌 소켓에 다시 쌓지 않고 버림
+// ==========================================
+void ClientSession::EnqueueSend(std::shared_ptr<SendBuffer> send_buf, uint16_t totalSize,
+                                SendClass send_class, uint64_t coalesce_key, bool needs_seal) {
+    if (disconnected_.load(std::memory_order_acquire)) return;
+
+    bool write_in_progress = !send_queue_.Empty();
+    PushResult result = send_queue_.Push(std::move(send_buf), static_cast<size_t>(totalSize),
+                                         send_class, coalesce_key, needs_seal);
+
+    const SendQueueStats& stats = send_queue_.GetStats();
+    if (result == PushResult::DROPPED) {
+        if (stats.dropped % GameConstants::Network::SEND_DROP_LOG_INTERVAL == 1) {
+            LOG_WARN("Gateway", "느린 클라이언트 이동 패킷 드랍 (유저: " << account_id_
+                << ", 대기: " << stats.queued_bytes << " bytes, 드랍 누적: " << stats.dropped
+                << ", 대체 누적: " << stats.coalesced << ")");
+        }
+        return;
+    }
+
+    if (result == PushResult::OVER_BUDGET) {
+        LOG_ERROR("Gateway", "송신 큐 hard 예산 초과로 연결 종료 (유저: " << account_id_
+            << ", 대기: " << stats.queued_bytes << " bytes, 최대: " << stats.peak_bytes
+            << " bytes, 드랍: " << stats.dropped << ", 대체: " << stats.coalesced << ")");
+        send_queue_.Clear();
+        boost::system::error_code ec;
+        socket_.close(ec);     // 진행 중인 DoRead는 operation_aborted(무시)로 종료됨
+        OnDisconnected();
+        return;
+    }
+
+    if (IsQueued(result) && !write_in_progress) {
+        DoWrite();
+    }
+}
+
+// gather write (SendQueue::PrepareBatch 참고, 봉인 지연 엔트리는 SealEntry로 암호화)
 void ClientSession::DoWrite() {
     auto self(shared_from_this());
-    auto& front_msg = send_queue_.front();
+
+    // 무효화/봉인 실패 엔트리만 실린 배치 -> 빈 async_write 없이 즉시 정리
+    auto batch = send_queue_.PrepareBatch([this](SendQueue::Entry& entry) { return SealEntry(entry); });
+    if (batch.empty()) {
+        send_queue_.FinishBatch(true);
+        OnSendQueueDrained();
+        return;
+    }
 
     boost::asio::async_write(socket_,
-        boost::asio::buffer(front_msg.first->buffer_.data(), front_msg.second),
+        batch,
         boost::asio::bind_executor(strand_, [this, self](boost::system::error_code ec, std::size_t) {
             if (!ec) {
-                send_queue_.pop_front();
-                if (!send_queue_.empty()) {
+                send_queue_.FinishBatch(true);
+                if (!send_queue_.Empty()) {
                     DoWrite();
                 }
+                else {
+                    OnSendQueueDrained();
+                }
             }
             else {
                 auto result = NetworkUtils::HandleError("ClientSession::DoWrite", ec);
                 LOG_ERROR("Gateway", "Client로 패킷 전송 실패 (DoWrite)");
-                send_queue_.clear();
+                send_queue_.FinishBatch(false);
+                send_queue_.Clear();
                 if (result.should_disconnect) {
                     OnDisconnected();
                 }
@@ -142,179 +396,172 @@ void ClientSession::DoWrite() {
         }));
 }
 
+// ==========================================
+//   DisconnectAfterFlush - 송신 큐를 비운 뒤 연결 종료
+//
+// Send()는 strand_에 적재를 post하므로 이 요청은 그 뒤에 실행됨
+//   -> 보낼 것이 남아 있으면 DoWrite 완료에서 큐가 빌 때 종료, 없으면 즉시 종료
+// ==========================================
+void ClientSession::DisconnectAfterFlush() {
+    auto self(shared_from_this());
+    boost::asio::post(strand_, [this, self]() {
+        close_after_flush_ = true;
+        if (send_queue_.Empty()) OnSendQueueDrained();
+    });
+}
+
+// 송신 큐가 비었을 때 (strand 내부 전용): 종료 예약이 있으면 지금 종료
+void ClientSession::OnSendQueueDrained() {
+    if (!close_after_flush_) return;
+
+    boost::system::error_code ec;
+    socket_.close(ec);     // 진행 중인 DoRead는 operation_aborted(무시)로 종료됨
+    OnDisconnected();
+}
+
+// ==========================================
+//   OnDisconnected - 종료 처리 (strand_ 안에서 호출, 1회만 수행)
+//
+// 유휴 회수, 송신 예산 초과, 읽기/쓰기 에러, 핸들러의 파싱 위반 종료가
+// 같은 세션에서 연달아 발생할 수 있음
+//   -> disconnected_ 교환으로 첫 호출만 LeaveReq 전송 + 핸들 반납 수행
+// ==========================================
 void ClientSession::OnDisconnected() {
+    if (disconnected_.exchange(true, std::memory_order_acq_rel)) return;
+
     if (!account_id_.empty()) {
         auto& ctx = GatewayContext::Get();
 
-        if (ctx.gameConnection) {
+        // 이동/공격과 같은 레인으로 보내야 퇴장이 앞선 요청을 추월하지 않음
+        if (GameConnection* lane = ctx.GetGameConnection(account_id_)) {
             Protocol::GatewayGameLeaveReq leave_req;
             leave_req.set_account_id(account_id_);
-            ctx.gameConnection->Send(Protocol::PKT_GATEWAY_GAME_LEAVE_REQ, leave_req);
+            lane->Send(Protocol::PKT_GATEWAY_GAME_LEAVE_REQ, leave_req);
         }
 
         UTILITY::LockGuard lock(ctx.clientMutex);
         ctx.clientMap.erase(account_id_);
+        ctx.ReleaseSessionHandle(session_handle_);
+        session_handle_ = 0;
         LOG_INFO("Gateway", "유저 접속 종료 및 맵에서 삭제됨: " << account_id_);
         account_id_ = "";
     }
 }
 
 // ==========================================
-// [참고] boost::asio::async_read의 완전 수신 보장 (composed operation)
+//   DoRead - 스트리밍 수신 (async_read_some + 링 버퍼)
 //
-// boost::asio::async_read는 요청한 바이트 수를 모두 수신할 때까지
-// 내부적으로 async_read_some을 반복 호출하는 composed operation입니다.
-// TCP 스트림에서 PacketHeader(4바이트)가 여러 TCP 세그먼트로 분할 수신되더라도,
-// 콜백은 반드시 4바이트를 모두 받은 후에만 호출됩니다.
+// 변경 전: async_read(헤더 4B) -> async_read(페이로드) 2단계 수신
+//   -> 패킷 1개당 recv 2회 + 완료 핸들러 2회
 //
-// 이와 달리 socket.async_read_some()은 사용 가능한 만큼만 읽으므로
-// 부분 수신이 발생할 수 있습니다. 이 프로젝트에서는 의도적으로
-// async_read(전체 읽기 보장)만 사용합니다.
-// (ref: boost.org/doc/libs/release/doc/html/boost_asio/reference/async_read.html)
+// 변경 후: 링 버퍼의 빈 공간 전체로 async_read_some 1회 수신
+//   -> 도착해 있는 바이트를 한 번에 가져온 뒤 ProcessFrames()에서 완성된 프레임을 모두 처리
+//   -> 부분 수신된 프레임은 링 버퍼에 남겨두고 다음 수신에서 이어붙임
+//
+// 완료 핸들러는 strand_에서 실행 (유휴 회수/송신 경로와 account_id_, 소켓 접근 직렬화)
 // ==========================================
-void ClientSession::ReadHeader() {
+void ClientSession::DoRead() {
     auto self(shared_from_this());
-    boost::asio::async_read(socket_, boost::asio::buffer(&header_, sizeof(PacketHeader)),
-        [this, self](boost::system::error_code ec, std::size_t length) {
+    socket_.async_read_some(stream_.GetWriteBuffers(),
+        boost::asio::bind_executor(strand_, [this, self](boost::system::error_code ec, std::size_t length) {
             if (!ec) {
-                // [패킷 파이프라인] 헤더 크기 검증
-                if (header_.size < sizeof(PacketHeader) || header_.size > MAX_PACKET_SIZE) {
-                    LOG_WARN("Gateway", "잘못된 패킷 헤더 크기: " << header_.size
-                        << " (유저: " << account_id_ << ") - 연결 종료");
+                last_recv_.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+                stream_.CommitWrite(length);
+                if (!ProcessFrames()) {
                     OnDisconnected();
                     return;
                 }
-
-                // [패킷 파이프라인] Rate Limiting 적용
-                if (!rate_limiter_.AllowPacket()) {
-                    rate_violation_count_++;
-                    LOG_WARN("Gateway", "Rate limit 초과! (유저: " << account_id_
-                        << ", 위반 횟수: " << rate_violation_count_
-                        << "/" << SecurityConstants::Packet::MAX_RATE_VIOLATIONS << ")");
-
-                    if (rate_violation_count_ >= SecurityConstants::Packet::MAX_RATE_VIOLATIONS) {
-                        LOG_ERROR("Gateway", "Rate limit 연속 초과로 연결 강제 종료: " << account_id_);
-                        OnDisconnected();
-                        return;
-                    }
-
-                    // 패킷 드랍: 페이로드를 읽되 처리하지 않음
-                    uint16_t payload_size = static_cast<uint16_t>(header_.size - sizeof(PacketHeader));
-                    if (payload_size > 0) {
-                        if (!assembler_.ValidatePayloadSize(payload_size)) {
-                            OnDisconnected();
-                            return;
-                        }
-                        auto self2 = self;
-                        boost::asio::async_read(socket_,
-                            boost::asio::buffer(assembler_.GetBuffer(), payload_size),
-                            [this, self2](boost::system::error_code ec2, std::size_t) {
-                                if (!ec2) ReadHeader();
-                                else OnDisconnected();
-                            });
-                    }
-                    else {
-                        ReadHeader();
-                    }
-                    return;
-                }
-                rate_violation_count_ = 0;
-
-                // [패킷 파이프라인] 패킷 ID 유효성 사전 검증
-                if (!GatewayContext::Get().clientDispatcher.HasHandler(header_.id)) {
-                    LOG_WARN("Gateway", "미등록 패킷 ID: " << header_.id
-                        << " (유저: " << account_id_ << ") - 패킷 드랍");
-                    uint16_t payload_size = static_cast<uint16_t>(header_.size - sizeof(PacketHeader));
-                    if (payload_size > 0) {
-                        if (!assembler_.ValidatePayloadSize(payload_size)) {
-                            OnDisconnected();
-                            return;
-                        }
-                        auto self2 = self;
-                        boost::asio::async_read(socket_,
-                            boost::asio::buffer(assembler_.GetBuffer(), payload_size),
-                            [this, self2](boost::system::error_code ec2, std::size_t) {
-                                if (!ec2) ReadHeader();
-                                else OnDisconnected();
-                            });
-                    }
-                    else {
-                        ReadHeader();
-                    }
-                    return;
-                }
-
-                uint16_t payload_size = static_cast<uint16_t>(header_.size - sizeof(PacketHeader));
-                if (payload_size == 0) {
-                    auto session_ptr = self;
-                    GatewayContext::Get().clientDispatcher.Dispatch(session_ptr, header_.id, nullptr, 0);
-                    ReadHeader();
-                }
-                else {
-                    if (!assembler_.ValidatePayloadSize(payload_size)) {
-                        LOG_WARN("Gateway", "페이로드 크기가 고정 버퍼 범위 초과: "
-                            << payload_size << " (유저: " << account_id_ << ")");
-                        OnDisconnected();
-                        return;
-                    }
-                    ReadPayload(payload_size);
-                }
+                DoRead();
             }
             else {
-                auto result = NetworkUtils::HandleError("ClientSession::ReadHeader", ec);
+                auto result = NetworkUtils::HandleError("ClientSession::DoRead", ec);
                 if (result.should_disconnect || 
                     NetworkUtils::ClassifyError(ec) != NetworkUtils::ErrorSeverity::IGNORED_ERROR) {
                     OnDisconnected();
                 }
             }
-        });
+        }));
 }
 
 // ==========================================
-//   ReadPayload — 복호화 통합
+//   ProcessFrames - 링 버퍼에 완성된 프레임을 모두 처리
 //
-// 변경 전: 수신된 바이트를 그대로 Dispatch에 전달
-// 변경 후: 암호화 활성 시 수신된 바이트를 복호화한 뒤 Dispatch에 전달
-//   복호화된 데이터는 원본 Protobuf 페이로드이므로
-//   핸들러의 ParseFromArray가 정상 동작함
+// 기존 ReadHeader/ReadPayload의 검증 파이프라인을 프레임 단위로 그대로 적용
+//   1. 헤더 크기 검증 (위반 시 연결 종료)
+//   2. Rate Limiting (초과 시 프레임 드랍, 연속 초과 시 연결 종료)
+//   3. 패킷 ID 유효성 검증 (미등록 ID는 프레임 드랍)
+//   4. 복호화 (암호화 활성 시) -> Dispatch
+//
+// 반환값: false면 연결 종료 대상
 // ==========================================
-void ClientSession::ReadPayload(uint16_t payload_size) {
+bool ClientSession::ProcessFrames() {
     auto self(shared_from_this());
-    boost::asio::async_read(socket_,
-        boost::asio::buffer(assembler_.GetBuffer(), payload_size),
-        [this, self, payload_size](boost::system::error_code ec, std::size_t length) {
-            if (!ec) {
-                char* dispatch_data = assembler_.GetPayloadData();
-                uint16_t dispatch_size = payload_size;
-
-                //   암호화 활성 시 복호화 수행
-                std::vector<char> decrypted_buf;
-                if (crypto_enabled_ && crypto_.IsInitialized()) {
-                    auto result = crypto_.Decrypt(dispatch_data, payload_size);
-                    if (result.success) {
-                        decrypted_buf = std::move(result.data);
-                        dispatch_data = decrypted_buf.data();
-                        dispatch_size = static_cast<uint16_t>(decrypted_buf.size());
-                    }
-                    else {
-                        LOG_ERROR("Gateway", "패킷 복호화 실패 (유저: " << account_id_
-                            << ") - " << result.error_message);
-                        OnDisconnected();
-                        return;
-                    }
-                }
+    auto& dispatcher = GatewayContext::Get().clientDispatcher;
+    PacketArena::BatchScope arena_scope;    // 읽기 1회분 요청 메시지를 끝에서 일괄 회수
+
+    PacketFrame frame;
+    while (true) {
+        FrameResult result = stream_.PeekFrame(frame);
+        if (result == FrameResult::INCOMPLETE) break;
+
+        // [패킷 파이프라인] 헤더 크기 검증
+        if (result == FrameResult::INVALID) {
+            LOG_WARN("Gateway", "잘못된 패킷 헤더 크기: " << frame.size
+                << " (유저: " << account_id_ << ") - 연결 종료");
+            return false;
+        }
 
-                auto session_ptr = self;
-                GatewayContext::Get().clientDispatcher.Dispatch(
-                    session_ptr, header_.id, dispatch_data, dispatch_size);
-                ReadHeader();
+        // [패킷 파이프라인] Rate Limiting 적용
+        if (!rate_limiter_.AllowPacket()) {
+            rate_violation_count_++;
+            LOG_WARN("Gateway", "Rate limit 초과! (유저: " << account_id_
+                << ", 위반 횟수: " << rate_violation_count_
+                << "/" << SecurityConstants::Packet::MAX_RATE_VIOLATIONS << ")");
+
+            if (rate_violation_count_ >= SecurityConstants::Packet::MAX_RATE_VIOLATIONS) {
+                LOG_ERROR("Gateway", "Rate limit 연속 초과로 연결 강제 종료: " << account_id_);
+                return false;
+            }
+
+            // 패킷 드랍: 프레임을 소비만 하고 처리하지 않음
+            stream_.ConsumeFrame(frame);
+            continue;
+        }
+        rate_violation_count_ = 0;
+
+        // [패킷 파이프라인] 패킷 ID 유효성 사전 검증 (조회 결과를 분배에 그대로 재사용)
+        auto* handler = dispatcher.Find(frame.id);
+        if (!handler) {
+            LOG_WARN("Gateway", "미등록 패킷 ID: " << frame.id
+                << " (유저: " << account_id_ << ") - 패킷 드랍");
+            stream_.ConsumeFrame(frame);
+            continue;
+        }
+
+        char* dispatch_data = frame.payload;
+        uint16_t dispatch_size = frame.payload_size;
+
+        //   암호화 활성 시 복호화 수행
+        //   프레임 버퍼(링/스크래치)에 제자리 복호화 -> 힙 할당 없이 평문 구간을 그대로 Dispatch
+        if (dispatch_size > 0 && crypto_enabled_ && crypto_.IsInitialized()) {
+            CryptoSpan crypt_result = crypto_.DecryptInPlace(dispatch_data, dispatch_size);
+            if (crypt_result.success) {
+                dispatch_data = crypt_result.data;
+                dispatch_size = crypt_result.size;
             }
             else {
-                auto result = NetworkUtils::HandleError("ClientSession::ReadPayload", ec);
-                if (result.should_disconnect || 
-                    NetworkUtils::ClassifyError(ec) != NetworkUtils::ErrorSeverity::IGNORED_ERROR) {
-                    OnDisconnected();
-                }
+                LOG_ERROR("Gateway", "패킷 복호화 실패 (유저: " << account_id_
+                    << ") - " << crypt_result.error_message);
+                return false;
             }
-        });
+        }
+
+        auto session_ptr = self;
+        PacketDispatcher<ClientSession>::Invoke(*handler, session_ptr, dispatch_data, dispatch_size);
+        stream_.ConsumeFrame(frame);
+
+        // 핸들러가 종료 처리한 세션(파싱 위반 등)은 남은 프레임을 처리하지 않고 수신 중단
+        if (disconnected_.load(std::memory_order_acquire)) return false;
+    }
+    return true;
 }
@@ -9,8 +9,14 @@
 #include "..\GatewayServer.h"
 #include "..\..\Common\PacketDispatcher.h"
 #include "..\..\Common\Network\PacketAssembler.h"
+#include "..\..\Common\Network\SendQueue.h"
+#include "..\..\Common\Network\SharedPacket.h"
+#include "..\..\Common\Define\GameConstants.h"
 #include "..\..\Common\Network\PacketCrypto.h"
 #include "..\..\Common\Define\SecurityConstants.h"
+#include "..\..\Common\Network\MoveCodec.h"
+#include <atomic>
+#include <chrono>
 
 struct SendBuffer;
 
@@ -36,14 +42,16 @@ class ClientSession : public std::enable_shared_from_this<ClientSession> {
 private:
     boost::asio::ip::tcp::socket socket_;
     boost::asio::io_context::strand strand_;
-    std::deque<std::pair<std::shared_ptr<SendBuffer>, size_t>> send_queue_;
+    SendQueue send_queue_;
 
-    PacketHeader header_;
-
-    PacketAssembler assembler_;
+    // 스트리밍 수신 링 버퍼 (async_read_some 1회에 여러 프레임 처리)
+    PacketStreamAssembler<GameConstants::Network::CLIENT_RECV_RING_SIZE> stream_;
 
     std::string account_id_ = "";
 
+    // 접속 승인 시 발급되는 세션 핸들 (GatewayContext::AllocateSessionHandle)
+    uint32_t session_handle_ = 0;
+
     // [패킷 파이프라인] 세션별 Rate Limiter
     PacketRateLimiter rate_limiter_;
     int rate_violation_count_ = 0;
@@ -55,14 +63,54 @@ private:
     PacketCrypto crypto_;
     bool crypto_enabled_ = false;
 
+    //   압축 이동 코덱 (GatewayConnectReq에서 협상, 인코더 상태는 strand_ 전용)
+    std::atomic<uint32_t> move_codec_flags_{ 0 };
+    MoveCodec::ObserverEncoder move_encoder_;
+
+    // ==========================================
+    //   유휴 연결 회수 (공용 TimingWheel)
+    //
+    // 변경 전: Gateway에는 유휴 감시가 없어 응답 없는 연결이 무기한 점유
+    // 변경 후: 수신 완료마다 last_recv_ 갱신(원자적 저장 1회),
+    //   CLIENT_IDLE_CHECK_SEC마다 휠 콜백이 strand에서 경과 시간 검사
+    //   -> CLIENT_IDLE_TIMEOUT_SEC 초과 시 연결 종료
+    //   -> 세션별 steady_timer 없음 (재무장은 휠 슬롯 push_back 1회)
+    // ==========================================
+    std::atomic<std::chrono::steady_clock::rep> last_recv_{ 0 };
+
+    // 종료 처리 1회 보장 (유휴 회수/송신 예산 초과/읽기 에러/파싱 위반이 겹쳐도 LeaveReq와 핸들 반납은 1번만)
+    std::atomic<bool> disconnected_{ false };
+
+    // 대기 중인 송신을 모두 보낸 뒤 연결 종료 (DisconnectAfterFlush, strand_ 전용)
+    bool close_after_flush_ = false;
+
 public:
     ClientSession(boost::asio::ip::tcp::socket socket) noexcept;
     void start();
     void SetAccountId(const std::string& id);
     const std::string& GetAccountId() const;
+    void SetSessionHandle(uint32_t handle) { session_handle_ = handle; }
+    uint32_t GetSessionHandle() const { return session_handle_; }
     void Send(uint16_t pktId, const google::protobuf::Message& msg);
+
+    // 이미 직렬화된 공유 패킷 전송 (팬아웃 경로, 암호화만 세션별 수행)
+    void SendShared(const SharedPacket& packet);
+
+    // 압축 이동 코덱 협상 결과
+    void SetMoveCodecFlags(uint32_t flags) { move_codec_flags_.store(flags, std::memory_order_relaxed); }
+    bool UsesCompactMove() const {
+        return (move_codec_flags_.load(std::memory_order_relaxed) & MoveCodec::FLAG_COMPACT_MOVE) != 0;
+    }
+
+    // 이 관찰자 기준으로 키프레임/델타를 골라 전송 (UsesCompactMove() 세션 전용)
+    void SendCompactMove(uint32_t entity, uint64_t account_hash,
+                         const std::shared_ptr<const std::string>& account_id,
+                         const MoveCodec::QuantizedMove& move);
     void OnDisconnected();
 
+    // 이미 적재된 응답(접속 거부 사유 등)을 보낸 뒤 연결 종료
+    void DisconnectAfterFlush();
+
     bool OnParseViolation();
     void OnParseSuccess();
 
@@ -71,7 +119,23 @@ public:
     void EnableEncryption();
 
 private:
-    void ReadHeader();
-    void ReadPayload(uint16_t payload_size);
+    void DoRead();
+    bool ProcessFrames();
     void DoWrite();
+    void OnSendQueueDrained();
+
+    void StartIdleCheck();
+    void OnIdleCheck();
+
+    // strand 내부에서 호출: 평문 페이로드를 풀 버퍼에 담아 적재 (레인은 패킷 ID 테이블로 결정)
+    void EnqueuePayload(uint16_t pktId, const char* payload, uint16_t payload_size,
+                        uint64_t coalesce_key);
+
+    // strand 내부에서 호출: 큐 상한 검사 후 적재 + 전송 시작
+    //   needs_seal이면 send_buf는 평문 프레임, totalSize는 암호화 후 크기
+    void EnqueueSend(std::shared_ptr<SendBuffer> send_buf, uint16_t totalSize,
+                     SendClass send_class, uint64_t coalesce_key, bool needs_seal = false);
+
+    // PrepareBatch 콜백: 봉인 지연 엔트리를 전송 순서대로 암호화
+    bool SealEntry(SendQueue::Entry& entry);
 };
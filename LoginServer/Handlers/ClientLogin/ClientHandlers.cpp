@@ -20,18 +20,18 @@
 //   -> ScopedConnection이 스코프 종료 시 자동 반납하여 누수 방지
 // ==========================================
 void Handle_LoginReq(std::shared_ptr<Session>& session, char* payload, uint16_t payloadSize) {
-    auto login_req = std::make_shared<Protocol::LoginReq>();
+    auto* login_req = PacketArena::Create<Protocol::LoginReq>();
 
     if (!login_req->ParseFromArray(payload, payloadSize)) {
         LOG_ERROR("LoginServer", "ParseFromArray 실패: LoginReq (payloadSize=" << payloadSize << ")");
         return;
     }
 
-    boost::asio::post(g_db_io_context, [session, login_req]() {
-        std::string req_id = login_req->id();
-        std::string req_pw = login_req->password();
-        int req_input_type = login_req->input_type();
-
+    // login_req는 이 스레드의 PacketArena 소유 -> 핸들러 반환 후 회수되므로 DB 스레드로는 값만 넘김
+    boost::asio::post(g_db_io_context, [session,
+        req_id = std::string(login_req->id()),
+        req_pw = std::string(login_req->password()),
+        req_input_type = static_cast<int>(login_req->input_type())]() {
         bool is_auth_success = false;
         int64_t account_uid = 0;
 
@@ -96,7 +96,7 @@ void Handle_LoginReq(std::shared_ptr<Session>& session, char* payload, uint16_t
 }
 
 void Handle_Heartbeat(std::shared_ptr<Session>& session, char* payload, uint16_t payloadSize) {
-    Protocol::Heartbeat hb;
+    auto& hb = *PacketArena::Create<Protocol::Heartbeat>();
 
     if (!hb.ParseFromArray(payload, payloadSize)) {
         LOG_ERROR("LoginServer", "ParseFromArray 실패: Heartbeat (payloadSize=" << payloadSize << ")");
@@ -109,7 +109,7 @@ void Handle_Heartbeat(std::shared_ptr<Session>& session, char* payload, uint16_t
 }
 
 void Handle_WorldSelectReq(std::shared_ptr<Session>& session, char* payload, uint16_t payloadSize) {
-    Protocol::WorldSelectReq req;
+    auto& req = *PacketArena::Create<Protocol::WorldSelectReq>();
 
     if (!req.ParseFromArray(payload, payloadSize)) {
         LOG_ERROR("LoginServer", "ParseFromArray 실패: WorldSelectReq (payloadSize=" << payloadSize << ")");
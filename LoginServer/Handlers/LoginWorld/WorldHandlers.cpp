@@ -5,7 +5,7 @@
 #include <iostream>
 
 void Handle_S2SWorldSelectRes(std::shared_ptr<WorldConnection>& world_conn, char* payload, uint16_t payloadSize) {
-    Protocol::WorldLoginSelectRes res;
+    auto& res = *PacketArena::Create<Protocol::WorldLoginSelectRes>();
 
     //   ParseFromArray 실패 시 로그 출력
     if (!res.ParseFromArray(payload, payloadSize)) {
@@ -8,6 +8,9 @@
 #include "..\Common\ConfigManager.h"
 #include "..\Common\MemoryPool.h"
 #include "..\Common\Utils\Logger.h"
+#include "..\Common\Network\IoContextPool.h"
+#include "..\Common\Network\TimingWheel.h"
+#include "..\Common\Define\GameConstants.h"
 
 #include <iostream>
 #include <windows.h>
@@ -20,6 +23,7 @@ using boost::asio::ip::tcp;
 // Graceful Shutdown을 위한 시그널 핸들러 추가
 // ==========================================
 static boost::asio::io_context* g_main_io_context_login = nullptr;
+static IoContextPool* g_core_pool_login = nullptr;   // thread-per-core 모드일 때만 설정
 
 static BOOL WINAPI LoginConsoleCtrlHandler(DWORD ctrlType) {
     if (ctrlType == CTRL_C_EVENT || ctrlType == CTRL_CLOSE_EVENT) {
@@ -27,6 +31,9 @@ static BOOL WINAPI LoginConsoleCtrlHandler(DWORD ctrlType) {
         if (g_main_io_context_login) {
             g_main_io_context_login->stop();
         }
+        if (g_core_pool_login) {
+            g_core_pool_login->Stop();
+        }
         auto& ctx = LoginContext::Get();
         ctx.is_running_.store(false);
         return TRUE;
@@ -37,20 +44,30 @@ static BOOL WINAPI LoginConsoleCtrlHandler(DWORD ctrlType) {
 class LoginServer {
     private:
         tcp::acceptor acceptor_;
+        IoContextPool* session_pool_ = nullptr;   // 설정 시 accept한 소켓을 풀의 io_context에 분배
     public:
         LoginServer(boost::asio::io_context& io_context, short port)
             : acceptor_(io_context, tcp::endpoint(tcp::v4(), port)) {
             do_accept();
         }
+
+        // thread-per-core 모드: SO_REUSEPORT acceptor(코어별) 또는 단일 acceptor + 풀 분배
+        LoginServer(tcp::acceptor acceptor, IoContextPool* session_pool)
+            : acceptor_(std::move(acceptor)), session_pool_(session_pool) {
+            do_accept();
+        }
     private:
         void do_accept() {
-            acceptor_.async_accept([this](boost::system::error_code ec, tcp::socket socket) {
+            auto on_accept = [this](boost::system::error_code ec, tcp::socket socket) {
                 if (!ec) {
                     LoginContext::Get().connected_clients++;
                     std::make_shared<Session>(std::move(socket))->start();
                 }
                 do_accept();
-                });
+                };
+
+            if (session_pool_) acceptor_.async_accept(session_pool_->GetNext(), on_accept);
+            else               acceptor_.async_accept(on_accept);
         }
 };
 
@@ -78,10 +95,10 @@ int main() {
 
     auto& ctx = LoginContext::Get();
 
-    ctx.clientDispatcher.RegisterHandler(Protocol::PKT_CLIENT_LOGIN_LOGIN_REQ,        Handle_LoginReq);
-    ctx.clientDispatcher.RegisterHandler(Protocol::PKT_CLIENT_SERVER_HEARTBEAT,       Handle_Heartbeat);
-    ctx.clientDispatcher.RegisterHandler(Protocol::PKT_CLIENT_LOGIN_WORLD_SELECT_REQ, Handle_WorldSelectReq);
-    ctx.worldDispatcher.RegisterHandler(Protocol::PKT_WORLD_LOGIN_SELECT_RES,         Handle_S2SWorldSelectRes);
+    ctx.clientDispatcher.RegisterHandler<&Handle_LoginReq>(Protocol::PKT_CLIENT_LOGIN_LOGIN_REQ);
+    ctx.clientDispatcher.RegisterHandler<&Handle_Heartbeat>(Protocol::PKT_CLIENT_SERVER_HEARTBEAT);
+    ctx.clientDispatcher.RegisterHandler<&Handle_WorldSelectReq>(Protocol::PKT_CLIENT_LOGIN_WORLD_SELECT_REQ);
+    ctx.worldDispatcher.RegisterHandler<&Handle_S2SWorldSelectRes>(Protocol::PKT_WORLD_LOGIN_SELECT_RES);
 
     ctx.worldDispatcher.RegisterHandler(Protocol::PKT_WORLD_GAME_TOKEN_NOTIFY,
         [](std::shared_ptr<WorldConnection>&, char*, uint16_t) {
@@ -94,13 +111,53 @@ int main() {
         // 시그널 핸들러용 포인터 저장
         g_main_io_context_login = &io_context;
 
+        // 세션 하트비트 검사용 공용 타이밍 휠 (메인 io_context는 두 모드 모두 run()됨)
+        //   -> guard가 io_context보다 먼저 소멸하며 휠 타이머를 해제
+        TimingWheel::ShutdownGuard wheel_guard;
+        TimingWheel::GetInstance().Start(io_context,
+            std::chrono::milliseconds(GameConstants::Network::TIMING_WHEEL_TICK_MS));
+
         ctx.worldConnection = std::make_shared<WorldConnection>(std::ref(io_context));
         short world_port = ConfigManager::GetInstance().GetLoginWorldConnPort();
         ctx.worldConnection->Connect("127.0.0.1", world_port);
 
+        unsigned int max_thread_count = ConfigManager::GetInstance().GetLoginMaxThreadCount();
+        if (max_thread_count == 0) max_thread_count = std::thread::hardware_concurrency();
+
+        // ==========================================
+        //   thread-per-core 모드 (login_server_info.thread_per_core)
+        //
+        // 클라이언트 세션은 코어별 io_context에 고정, 메인 io_context는
+        // WorldServer S2S 연결 전용으로 스레드 1개만 run()
+        // (DB 작업은 기존처럼 db_io_context로 post 후 세션 strand로 복귀)
+        // ==========================================
+        bool per_core = ConfigManager::GetInstance().IsLoginThreadPerCore();
+        std::unique_ptr<IoContextPool> core_pool;
+        if (per_core) {
+            core_pool = std::make_unique<IoContextPool>(max_thread_count);
+            g_core_pool_login = core_pool.get();
+        }
+
         short login_port = ConfigManager::GetInstance().GetLoginServerPort();
-        LoginServer server(io_context, login_port);
+        std::vector<std::unique_ptr<LoginServer>> servers;
+        if (!per_core) {
+            servers.push_back(std::make_unique<LoginServer>(io_context, login_port));
+        }
+        else if (IoContextPoolUtil::HAS_REUSE_PORT) {
+            for (size_t i = 0; i < core_pool->Size(); ++i) {
+                servers.push_back(std::make_unique<LoginServer>(
+                    IoContextPoolUtil::OpenAcceptor(core_pool->Get(i), login_port, true), nullptr));
+            }
+        }
+        else {
+            servers.push_back(std::make_unique<LoginServer>(
+                IoContextPoolUtil::OpenAcceptor(core_pool->Get(0), login_port, false), core_pool.get()));
+        }
         LOG_INFO("LoginServer", "로그인 서버 가동 시작 (Port: " << login_port << ") Created by Jeong Shin Young");
+        if (per_core) {
+            LOG_INFO("LoginServer", "thread-per-core 모드: io_context " << core_pool->Size() << "개 ("
+                << (IoContextPoolUtil::HAS_REUSE_PORT ? "SO_REUSEPORT acceptor" : "단일 acceptor 분배") << ")");
+        }
 
         // ==========================================
         //   thread_local DBManager → DBConnectionPool 전환
@@ -138,14 +195,19 @@ int main() {
             });
         }
 
-        unsigned int max_thread_count = ConfigManager::GetInstance().GetLoginMaxThreadCount();
-        if (max_thread_count == 0) max_thread_count = std::thread::hardware_concurrency();
-
-        std::vector<std::thread> threads;
-        for (unsigned int i = 0; i < max_thread_count; ++i) {
-            threads.emplace_back([&io_context]() { io_context.run(); });
+        if (per_core) {
+            core_pool->Run();
+            io_context.run();   // S2S 전용 (종료 신호 시 stop)
+            core_pool->Join();
+            g_core_pool_login = nullptr;
+        }
+        else {
+            std::vector<std::thread> threads;
+            for (unsigned int i = 0; i < max_thread_count; ++i) {
+                threads.emplace_back([&io_context]() { io_context.run(); });
+            }
+            for (auto& t : threads) { if (t.joinable()) t.join(); }
         }
-        for (auto& t : threads) { if (t.joinable()) t.join(); }
     }
     catch (std::exception& e) {
         LOG_FATAL("Error", "서버 예외 발생: " << e.what());
@@ -2,16 +2,15 @@
 #include "../../Common/MemoryPool.h"
 #include "../../Common/Define/GameConstants.h"
 #include "../../Common/Define/LoginConstants.h"
+#include "../../Common/Network/TimingWheel.h"
 #include <iostream>
 
 using boost::asio::ip::tcp;
 
-//   heartbeat_timer_를 소켓의 executor에서 생성 (별도 io_context 불필요)
 //   strand_ 초기화 추가
 Session::Session(tcp::socket socket) noexcept
     : socket_(std::move(socket))
     , strand_(static_cast<boost::asio::io_context&>(socket_.get_executor().context()))
-    , heartbeat_timer_(socket_.get_executor())
     , last_heartbeat_(std::chrono::steady_clock::now())
 {}
 
@@ -24,34 +23,45 @@ void Session::start() {
 // ==========================================
 //   Heartbeat 타임아웃 체크 구현
 //
-// LoginConstants::Heartbeat::CHECK_INTERVAL_SECONDS 마다 타이머가 깨어나서
+// LoginConstants::Heartbeat::CHECK_INTERVAL_SECONDS 마다 검사가 깨어나서
 // 마지막 하트비트로부터 TIMEOUT_SECONDS 초가 넘었으면 연결을 끊습니다.
 //
 //   하드코딩된 매직 넘버(15, 30)를 LoginConstants로 교체
+//   세션별 steady_timer 대신 공용 TimingWheel에 등록
+//   -> 휠은 세션을 weak_ptr로만 잡으므로 종료된 세션의 수명을 늘리지 않음
+//   -> 검사 자체는 세션 strand에서 실행
+//   -> ReadHeader/ReadPayload 완료 핸들러도 strand_에 바인딩되어 있으므로
+//      검사의 socket_.close()/OnDisconnected()와 socket_, last_heartbeat_, logged_in_id_를 두고 경합하지 않음
 // ==========================================
 void Session::StartHeartbeatCheck() {
-    auto self(shared_from_this());
-    heartbeat_timer_.expires_after(
-        std::chrono::seconds(LoginConstants::Heartbeat::CHECK_INTERVAL_SECONDS));
-    heartbeat_timer_.async_wait([this, self](boost::system::error_code ec) {
-        if (ec) {
-            // timer가 취소됐거나(operation_aborted) 세션이 이미 종료된 경우
-            return;
-        }
+    std::weak_ptr<Session> weak = shared_from_this();
+    TimingWheel::GetInstance().Schedule(
+        std::chrono::seconds(LoginConstants::Heartbeat::CHECK_INTERVAL_SECONDS),
+        [weak]() {
+            auto self = weak.lock();
+            if (!self) return;
+            boost::asio::post(self->strand_, [self]() { self->OnHeartbeatCheck(); });
+        });
+}
 
-        auto now = std::chrono::steady_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
-            now - last_heartbeat_).count();
+void Session::OnHeartbeatCheck() {
+    // 세션이 이미 종료된 경우 (휠에는 취소가 없으므로 여기서 무시)
+    if (heartbeat_stopped_.load(std::memory_order_acquire)) return;
 
-        if (elapsed > LoginConstants::Heartbeat::TIMEOUT_SECONDS) {
-            std::cerr << "[LoginServer] 하트비트 타임아웃! 유저("
-                << logged_in_id_ << ") " << elapsed << "초 동안 응답 없음. 연결 종료.\n";
-            OnDisconnected();
-            return;
-        }
+    auto now = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
+        now - last_heartbeat_).count();
 
-        StartHeartbeatCheck();
-    });
+    if (elapsed > LoginConstants::Heartbeat::TIMEOUT_SECONDS) {
+        std::cerr << "[LoginServer] 하트비트 타임아웃! 유저("
+            << logged_in_id_ << ") " << elapsed << "초 동안 응답 없음. 연결 종료.\n";
+        boost::system::error_code ec;
+        socket_.close(ec);      // 대기 중인 ReadHeader/ReadPayload는 에러로 종료됨
+        OnDisconnected();
+        return;
+    }
+
+    StartHeartbeatCheck();
 }
 
 // ==========================================
@@ -70,56 +80,63 @@ void Session::Send(uint16_t pktId, const google::protobuf::Message& msg) {
     }
 
     // 메모리 풀에서 버퍼 대여 (전송 완료 시 SendBufferDeleter가 자동 반납)
-    SendBuffer* raw_buf = SendBufferPool::GetInstance().Acquire();
+    SendBuffer* raw_buf = SendBufferPool::GetInstance().Acquire(totalSize);
     std::shared_ptr<SendBuffer> send_buf(raw_buf, SendBufferDeleter());
 
     PacketHeader header;
     header.size = totalSize;
     header.id = pktId;
-    memcpy(send_buf->buffer_.data(), &header, sizeof(PacketHeader));
-    msg.SerializeToArray(send_buf->buffer_.data() + sizeof(PacketHeader), payloadSize);
+    memcpy(send_buf->Data(), &header, sizeof(PacketHeader));
+    msg.SerializeToArray(send_buf->Data() + sizeof(PacketHeader), payloadSize);
 
     auto self(shared_from_this());
     boost::asio::post(strand_, [this, self, send_buf, totalSize]() {
-        if (send_queue_.size() > GameConstants::Network::SEND_QUEUE_MAX_SIZE) {
+        if (send_queue_.Size() > GameConstants::Network::SEND_QUEUE_MAX_SIZE) {
             std::cerr << "[LoginServer] Session Send Queue 폭발! 전송 드랍.\n";
             return;
         }
 
-        bool write_in_progress = !send_queue_.empty();
-        send_queue_.emplace_back(send_buf, static_cast<size_t>(totalSize));
+        bool write_in_progress = !send_queue_.Empty();
+        PushResult result = send_queue_.Push(send_buf, static_cast<size_t>(totalSize));
 
-        if (!write_in_progress) {
+        if (IsQueued(result) && !write_in_progress) {
             DoWrite();
         }
     });
 }
 
-//   실제 비동기 전송을 수행하는 함수
+// gather write (SendQueue::PrepareBatch 참고)
 void Session::DoWrite() {
     auto self(shared_from_this());
-    auto& front_msg = send_queue_.front();
+
+    // 무효화 엔트리만 실린 배치 -> 빈 async_write 없이 즉시 정리 (SendQueue::PrepareBatch 참고)
+    auto batch = send_queue_.PrepareBatch();
+    if (batch.empty()) {
+        send_queue_.FinishBatch(true);
+        return;
+    }
 
     boost::asio::async_write(socket_,
-        boost::asio::buffer(front_msg.first->buffer_.data(), front_msg.second),
+        batch,
         boost::asio::bind_executor(strand_, [this, self](boost::system::error_code ec, std::size_t) {
             if (!ec) {
-                send_queue_.pop_front();
-                if (!send_queue_.empty()) {
+                send_queue_.FinishBatch(true);
+                if (!send_queue_.Empty()) {
                     DoWrite();
                 }
             }
             else {
                 std::cerr << "[LoginServer] 패킷 전송 실패 (DoWrite, 유저: "
                     << logged_in_id_ << "): " << ec.message() << "\n";
-                send_queue_.clear();
+                send_queue_.FinishBatch(false);
+                send_queue_.Clear();
             }
         }));
 }
 
 void Session::OnDisconnected() {
-    // 타이머 취소 (OnDisconnected가 여러 번 호출되지 않도록)
-    heartbeat_timer_.cancel();
+    // 하트비트 검사 중단 + 중복 호출 방지 (타임아웃 종료 후 읽기 에러로 다시 들어오는 경우)
+    if (heartbeat_stopped_.exchange(true, std::memory_order_acq_rel)) return;
 
     int current_count = --g_connected_clients;
     std::cout << "[LoginServer] 유저 접속 종료 (접속자: " << current_count << "명)\n";
@@ -139,7 +156,7 @@ void Session::OnDisconnected() {
 void Session::ReadHeader() {
     auto self(shared_from_this());
     boost::asio::async_read(socket_, boost::asio::buffer(&header_, sizeof(PacketHeader)),
-        [this, self](boost::system::error_code ec, std::size_t length) {
+        boost::asio::bind_executor(strand_, [this, self](boost::system::error_code ec, std::size_t length) {
             if (!ec) {
                 if (header_.size < sizeof(PacketHeader) || header_.size > MAX_PACKET_SIZE) {
                     //   에러 핸들링: 잘못된 헤더 크기 로그
@@ -172,7 +189,7 @@ void Session::ReadHeader() {
                 }
                 OnDisconnected();
             }
-        });
+        }));
 }
 
 // ==========================================
@@ -185,7 +202,7 @@ void Session::ReadPayload(uint16_t payload_size) {
     auto self(shared_from_this());
     boost::asio::async_read(socket_,
         boost::asio::buffer(assembler_.GetBuffer(), payload_size),
-        [this, self, payload_size](boost::system::error_code ec, std::size_t length) {
+        boost::asio::bind_executor(strand_, [this, self, payload_size](boost::system::error_code ec, std::size_t length) {
             if (!ec) {
                 auto session_ptr = self;
                 g_client_dispatcher.Dispatch(
@@ -200,5 +217,5 @@ void Session::ReadPayload(uint16_t payload_size) {
                 }
                 OnDisconnected();
             }
-        });
+        }));
 }
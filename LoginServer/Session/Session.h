@@ -14,7 +14,9 @@
 
 #include "../LoginServer.h"
 #include "../../Common/Network/PacketAssembler.h"
+#include "../../Common/Network/SendQueue.h"
 #include "../../Common/Define/LoginConstants.h"
+#include <atomic>
 
 struct SendBuffer; // 전방 선언
 
@@ -35,7 +37,7 @@ private:
 
     //   strand + send_queue: concurrent async_write 방지
     boost::asio::io_context::strand strand_;
-    std::deque<std::pair<std::shared_ptr<SendBuffer>, size_t>> send_queue_;
+    SendQueue send_queue_;
 
     PacketHeader header_;
 
@@ -51,8 +53,12 @@ private:
     // 변경 후: last_heartbeat_ 갱신 + steady_timer로 주기 체크 → 타임아웃 시 강제 연결 종료
     //
     //   하드코딩된 매직 넘버(15, 30)를 LoginConstants로 교체
+    //
+    //   세션별 steady_timer -> 공용 TimingWheel 등록으로 교체
+    //   -> 세션당 타이머 객체/타이머 힙 엔트리 없음, 재무장은 휠 슬롯 push_back 1회
+    //   -> 휠에는 취소가 없으므로 종료 후 도착한 검사는 heartbeat_stopped_로 무시
     // ==========================================
-    boost::asio::steady_timer heartbeat_timer_;
+    std::atomic<bool> heartbeat_stopped_{ false };
     std::chrono::steady_clock::time_point last_heartbeat_;
 
 public:
@@ -72,6 +78,7 @@ private:
     void ReadHeader();
     void ReadPayload(uint16_t payload_size);
     void StartHeartbeatCheck();
+    void OnHeartbeatCheck();
 
     //   큐에서 패킷을 꺼내 실제로 전송하는 내부 함수
     void DoWrite();
@@ -3,6 +3,7 @@
 #include "../../Common/ConfigManager.h"
 #include "../../Common/Define/StressConstants.h"
 #include "../../Common/Define/SecurityConstants.h"
+#include "../../Common/Network/TimingWheel.h"
 
 #include <iostream>
 #include <random>
@@ -10,7 +11,7 @@
 using boost::asio::ip::tcp;
 
 StressSession::StressSession(boost::asio::io_context& io, StressManager* manager, const std::string& account_id)
-    : socket_(io), strand_(io), io_context_(io), action_timer_(io), manager_(manager), account_id_(account_id) {
+    : socket_(io), strand_(io), io_context_(io), manager_(manager), account_id_(account_id) {
 
     static thread_local std::mt19937 gen(std::random_device{}());
     std::uniform_real_distribution<float> dis(0.0f, StressConstants::BotAI::SPAWN_RANGE);
@@ -39,7 +40,7 @@ void StressSession::Stop() {
 
         boost::system::error_code ec;
         socket_.close(ec);
-        action_timer_.cancel();
+        ++action_gen_;     // 대기 중인 행동 타이머 무효화
         send_queue_.clear();
     });
 }
@@ -116,19 +117,21 @@ void StressSession::ReadPayload(uint16_t payload_size) {
                 // 암호화 활성 시 수신 페이로드 복호화
                 char* dispatch_data = payload_buf_.data();
                 uint16_t dispatch_size = payload_size;
-                std::vector<char> decrypted_buf;
 
                 if (crypto_enabled_ && crypto_.IsInitialized() && payload_size > 0) {
-                    auto result = crypto_.Decrypt(dispatch_data, payload_size);
+                    // payload_buf_에 제자리 복호화 (패킷마다 vector 할당 제거)
+                    CryptoSpan result = crypto_.DecryptInPlace(dispatch_data, payload_size);
                     if (result.success) {
-                        decrypted_buf = std::move(result.data);
-                        dispatch_data = decrypted_buf.data();
-                        dispatch_size = static_cast<uint16_t>(decrypted_buf.size());
+                        dispatch_data = result.data;
+                        dispatch_size = result.size;
                     }
                     else {
-                        // 복호화 실패 시 평문으로 시도 (핸드셰이크 패킷일 수 있음)
-                        dispatch_data = payload_buf_.data();
-                        dispatch_size = payload_size;
+                        // 핸드셰이크 이후에는 모든 패킷이 암호문 -> 평문 재해석 없이 프로토콜 오류로 종료
+                        //   (ClientSession::ProcessFrames와 동일한 정책)
+                        std::cerr << "[StressSession] 패킷 복호화 실패 (PktID: " << header_.id
+                            << ", 봇: " << account_id_ << ") - " << result.error_message << "\n";
+                        Stop();
+                        return;
                     }
                 }
 
@@ -205,78 +208,93 @@ void StressSession::ScheduleNextAction() {
         StressConstants::BotAI::MIN_ACTION_DELAY_MS,
         StressConstants::BotAI::MAX_ACTION_DELAY_MS);
 
-    action_timer_.expires_after(std::chrono::milliseconds(delay_dis(gen)));
-    auto self = shared_from_this();
+    uint64_t action_gen = ++action_gen_;
+    std::weak_ptr<StressSession> weak = shared_from_this();
 
-    action_timer_.async_wait(boost::asio::bind_executor(strand_, [this, self](boost::system::error_code ec) {
-        if (!ec && state_ == BotState::IN_GAME)
-        {
-            static thread_local std::mt19937 gen_inner(std::random_device{}());
-            std::uniform_int_distribution<> action_dis(1, 100);
-
-            int action = action_dis(gen_inner);
-            if (action <= StressConstants::BotAI::ACTION_MOVE_PERCENT) {
-                std::uniform_real_distribution<float> move_dis(
-                    -StressConstants::BotAI::MOVE_RANGE,
-                     StressConstants::BotAI::MOVE_RANGE);
-                x_ += move_dis(gen_inner);
-                y_ += move_dis(gen_inner);
-
-                Protocol::MoveReq move_req;
-                move_req.set_x(x_);
-                move_req.set_y(y_);
-                move_req.set_z(0.0f);
-                move_req.set_yaw(0.0f);
-                SendPacket(Protocol::PKT_CLIENT_GATEWAY_MOVE_REQ, move_req);
-            }
-            else {
-                Protocol::AttackReq atk_req;
-                atk_req.set_target_uid(0);
-                SendPacket(Protocol::PKT_CLIENT_GATEWAY_ATTACK_REQ, atk_req);
-            }
+    TimingWheel::GetInstance().Schedule(std::chrono::milliseconds(delay_dis(gen)), [weak, action_gen]() {
+        auto self = weak.lock();
+        if (!self) return;
+        boost::asio::post(self->strand_, [self, action_gen]() { self->OnActionTimer(action_gen); });
+    });
+}
 
-            ScheduleNextAction();
-        }
-    }));
+void StressSession::OnActionTimer(uint64_t action_gen) {
+    if (action_gen != action_gen_ || state_ != BotState::IN_GAME) return;
+
+    static thread_local std::mt19937 gen_inner(std::random_device{}());
+    std::uniform_int_distribution<> action_dis(1, 100);
+
+    int action = action_dis(gen_inner);
+    if (action <= StressConstants::BotAI::ACTION_MOVE_PERCENT) {
+        std::uniform_real_distribution<float> move_dis(
+            -StressConstants::BotAI::MOVE_RANGE,
+             StressConstants::BotAI::MOVE_RANGE);
+        x_ += move_dis(gen_inner);
+        y_ += move_dis(gen_inner);
+
+        Protocol::MoveReq move_req;
+        move_req.set_x(x_);
+        move_req.set_y(y_);
+        move_req.set_z(0.0f);
+        move_req.set_yaw(0.0f);
+        SendPacket(Protocol::PKT_CLIENT_GATEWAY_MOVE_REQ, move_req);
+    }
+    else {
+        Protocol::AttackReq atk_req;
+        atk_req.set_target_uid(0);
+        SendPacket(Protocol::PKT_CLIENT_GATEWAY_ATTACK_REQ, atk_req);
+    }
+
+    ScheduleNextAction();
 }
 
 // ==========================================
-// SendPacket — 암호화 통합
+// SendPacket — 암호화 통합 + 제로 카피 송신 경로
 //
 // IN_GAME 상태에서 암호화가 활성화되어 있으면
 // Protobuf 직렬화 후 AES-128-CBC로 암호화하여 전송합니다.
 // LoginServer 통신(WAITING_LOGIN_RES)에서는 암호화가 비활성이므로 평문 전송됩니다.
+//
+// 변경 전: SerializeToString -> Encrypt(vector) -> make_shared<vector> + memcpy × 2
+// 변경 후: 풀 버퍼 하나에 [Header][SeqNum][IV][Payload] 자리를 잡고
+//   평문 위치에 SerializeToArray로 직접 직렬화 -> strand 안에서 제자리 암호화
+//   (시퀀스 발급 순서 = 전송 순서 보장)
 // ==========================================
 void StressSession::SendPacket(uint16_t pktId, const google::protobuf::Message& msg) {
-    std::string serialized;
-    msg.SerializeToString(&serialized);
-
-    // 암호화 (활성화된 경우)
-    std::vector<char> final_payload;
-    if (crypto_enabled_ && crypto_.IsInitialized()) {
-        auto result = crypto_.Encrypt(serialized.data(), static_cast<uint16_t>(serialized.size()));
-        if (result.success) {
-            final_payload = std::move(result.data);
-        }
-        else {
-            final_payload.assign(serialized.begin(), serialized.end());
-        }
-    }
-    else {
-        final_payload.assign(serialized.begin(), serialized.end());
+    size_t payload_size = msg.ByteSizeLong();
+    bool encrypt = crypto_enabled_ && crypto_.IsInitialized() && payload_size > 0;
+
+    size_t wire_payload = encrypt ? CryptoConstants::GetEncryptedSize(payload_size) : payload_size;
+    size_t reserve_size = sizeof(PacketHeader) + wire_payload;
+    if (reserve_size > MAX_PACKET_SIZE) {
+        std::cerr << "[StressSession] 패킷 크기 초과! (PktID: " << pktId << ", Size: " << reserve_size << ")\n";
+        return;
     }
 
-    PacketHeader header{ static_cast<uint16_t>(sizeof(PacketHeader) + final_payload.size()), pktId };
+    SendBuffer* raw_buf = SendBufferPool::GetInstance().Acquire(reserve_size);
+    std::shared_ptr<SendBuffer> send_buf(raw_buf, SendBufferDeleter());
 
-    auto send_buf = std::make_shared<std::vector<char>>(header.size);
-    memcpy(send_buf->data(), &header, sizeof(PacketHeader));
-    memcpy(send_buf->data() + sizeof(PacketHeader), final_payload.data(), final_payload.size());
+    size_t plain_offset = sizeof(PacketHeader) + (encrypt ? CryptoConstants::CRYPTO_HEADER_SIZE : 0);
+    msg.SerializeToArray(send_buf->Data() + plain_offset, static_cast<int>(payload_size));
 
     auto self = shared_from_this();
     // 여러 스레드가 동시에 SendPacket을 호출해도, strand를 통해 안전하게 큐에 쌓임
-    boost::asio::post(strand_, [this, self, send_buf]() {
+    boost::asio::post(strand_, [this, self, send_buf, pktId, payload_size, plain_offset, encrypt, reserve_size]() {
+        char* base = send_buf->Data();
+        uint16_t total_size = static_cast<uint16_t>(reserve_size);
+
+        if (encrypt) {
+            size_t written = crypto_.EncryptInto(base + plain_offset, static_cast<uint16_t>(payload_size),
+                base + sizeof(PacketHeader), send_buf->Capacity() - sizeof(PacketHeader));
+            if (written == 0) return;
+            total_size = static_cast<uint16_t>(sizeof(PacketHeader) + written);
+        }
+
+        PacketHeader header{ total_size, pktId };
+        memcpy(base, &header, sizeof(PacketHeader));
+
         bool write_in_progress = !send_queue_.empty();
-        send_queue_.push_back(send_buf);
+        send_queue_.push_back({ send_buf, total_size });
         if (!write_in_progress) {
             DoWrite();
         }
@@ -286,9 +304,9 @@ void StressSession::SendPacket(uint16_t pktId, const google::protobuf::Message&
 // 큐의 맨 앞 패킷부터 하나씩 꺼내어 전송
 void StressSession::DoWrite() {
     auto self = shared_from_this();
-    auto buf = send_queue_.front();
+    const PendingSend& front = send_queue_.front();
 
-    boost::asio::async_write(socket_, boost::asio::buffer(*buf),
+    boost::asio::async_write(socket_, boost::asio::buffer(front.buffer->Data(), front.size),
         boost::asio::bind_executor(strand_, [this, self](boost::system::error_code ec, std::size_t) {
             if (!ec) {
                 if (state_ == BotState::IN_GAME) {
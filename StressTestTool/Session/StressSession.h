@@ -12,6 +12,7 @@
 
 #include "../../Common/Define/StressConstants.h"
 #include "../../Common/Network/PacketCrypto.h"
+#include "../../Common/MemoryPool.h"
 
 class StressManager;
 
@@ -37,10 +38,19 @@ private:
 
     // 동시 접근 방지 & 전송 대기열
     boost::asio::io_context::strand strand_;
-    std::deque<std::shared_ptr<std::vector<char>>> send_queue_;
+    //   송신 버퍼: make_shared<vector<char>> -> SendBufferPool 대여 (풀 버퍼 + 실제 전송 크기)
+    struct PendingSend {
+        std::shared_ptr<SendBuffer> buffer;
+        uint16_t size;
+    };
+    std::deque<PendingSend> send_queue_;
 
     boost::asio::io_context& io_context_;
-    boost::asio::steady_timer action_timer_;
+
+    // 봇 행동 타이머: 세션별 steady_timer 대신 공용 TimingWheel에 등록
+    //   -> 휠에는 취소가 없으므로 예약마다 세대를 올리고, 도착한 콜백의 세대가
+    //      현재와 다르면(Stop/재예약됨) 무시 (strand_ 안에서만 접근)
+    uint64_t action_gen_ = 0;
 
     BotState state_ = BotState::DISCONNECTED;
 
@@ -87,6 +97,7 @@ private:
     void ConnectToLogin();
     void ConnectToGateway(const std::string& ip, short port);
     void ScheduleNextAction(); // IN_GAME 상태에서 랜덤 이동/공격을 지시하는 AI 루프
+    void OnActionTimer(uint64_t gen);
     
     void DoWrite();     // 실제 비동기 전송을 수행하는 함수
 };
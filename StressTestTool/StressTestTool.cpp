@@ -6,6 +6,8 @@
 #include "../StressTestTool/Manager/StressManager.h"
 #include "../Common/ConfigManager.h"
 #include "../Common/Define/StressConstants.h"
+#include "../Common/MemoryPool.h"
+#include "../Common/Network/TimingWheel.h"
 
 int main() {
     SetConsoleOutputCP(CP_UTF8);
@@ -31,6 +33,9 @@ int main() {
         return -1;
     }
 
+    // 봇 송신 버퍼 풀 (SendPacket이 풀 버퍼에 직접 직렬화/암호화)
+    SendBufferPool::GetInstance().Initialize(PoolConfig::HEAVY_SERVER);
+
     // ==========================================
     // ⚙️ 부하 테스트 설정값
     // ==========================================
@@ -44,6 +49,12 @@ int main() {
     if (TARGET_CONNECTIONS > StressConstants::BotAI::MAX_TARGET_CONNECTION)
         TARGET_CONNECTIONS = StressConstants::BotAI::MAX_TARGET_CONNECTION;
 
+    // 봇 행동 타이머용 공용 타이밍 휠 (봇마다 steady_timer를 두지 않음)
+    //   -> guard가 io_context보다 먼저 소멸하며 휠 타이머를 해제
+    TimingWheel::ShutdownGuard wheel_guard;
+    TimingWheel::GetInstance().Start(io_context,
+        std::chrono::milliseconds(StressConstants::BotAI::ACTION_WHEEL_TICK_MS));
+
     StressManager manager(io_context, TARGET_CONNECTIONS, SPAWN_RATE);
     manager.StartStressTest();
 
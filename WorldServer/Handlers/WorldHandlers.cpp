@@ -18,7 +18,7 @@
 // 4. GatewayServer는 클라이언트 접속 시 토큰을 검증합니다.
 // ==========================================
 void Handle_WorldLoginSelectReq(std::shared_ptr<ServerSession>& session, char* payload, uint16_t payloadSize) {
-    Protocol::LoginWorldSelectReq req;
+    auto& req = *PacketArena::Create<Protocol::LoginWorldSelectReq>();
     if (!req.ParseFromArray(payload, payloadSize)) {
         LOG_ERROR("WorldServer", "ParseFromArray 실패: LoginWorldSelectReq (payloadSize=" << payloadSize << ")");
         return;
@@ -44,7 +44,7 @@ ServerSession::ServerSession(tcp::socket socket) noexcept
 {}
 
 void ServerSession::start() {
-    ReadHeader();
+    DoRead();
 }
 
 // ==========================================
@@ -64,73 +64,68 @@ void ServerSession::Send(uint16_t pktId, const google::protobuf::Message& msg) {
         return;
     }
 
-    SendBuffer* raw_buf = SendBufferPool::GetInstance().Acquire();
+    SendBuffer* raw_buf = SendBufferPool::GetInstance().Acquire(totalSize);
     std::shared_ptr<SendBuffer> send_buf(raw_buf, SendBufferDeleter());
 
     PacketHeader header{ totalSize, pktId };
-    memcpy(send_buf->buffer_.data(), &header, sizeof(PacketHeader));
-    msg.SerializeToArray(send_buf->buffer_.data() + sizeof(PacketHeader), payloadSize);
+    memcpy(send_buf->Data(), &header, sizeof(PacketHeader));
+    msg.SerializeToArray(send_buf->Data() + sizeof(PacketHeader), payloadSize);
 
     auto self(shared_from_this());
     boost::asio::post(strand_, [this, self, send_buf, totalSize]() {
-        bool write_in_progress = !send_queue_.empty();
-        send_queue_.emplace_back(send_buf, static_cast<size_t>(totalSize));
-        if (!write_in_progress) {
+        bool write_in_progress = !send_queue_.Empty();
+        PushResult result = send_queue_.Push(send_buf, static_cast<size_t>(totalSize));
+        if (IsQueued(result) && !write_in_progress) {
             DoWrite();
         }
     });
 }
 
+// gather write (SendQueue::PrepareBatch 참고)
 void ServerSession::DoWrite() {
     auto self(shared_from_this());
-    auto& front_msg = send_queue_.front();
+
+    // 무효화 엔트리만 실린 배치 -> 빈 async_write 없이 즉시 정리 (SendQueue::PrepareBatch 참고)
+    auto batch = send_queue_.PrepareBatch();
+    if (batch.empty()) {
+        send_queue_.FinishBatch(true);
+        return;
+    }
 
     boost::asio::async_write(socket_,
-        boost::asio::buffer(front_msg.first->buffer_.data(), front_msg.second),
+        batch,
         boost::asio::bind_executor(strand_, [this, self](boost::system::error_code ec, std::size_t) {
             if (!ec) {
-                send_queue_.pop_front();
-                if (!send_queue_.empty()) {
+                send_queue_.FinishBatch(true);
+                if (!send_queue_.Empty()) {
                     DoWrite();
                 }
             }
             else {
                 LOG_ERROR("WorldServer", "S2S 패킷 전송 실패 (DoWrite): " << ec.message());
-                send_queue_.clear();
+                send_queue_.FinishBatch(false);
+                send_queue_.Clear();
             }
         }));
 }
 
 // ==========================================
-// ReadHeader - PacketAssembler 고정 버퍼 사용
+// DoRead - 스트리밍 수신 (async_read_some + 링 버퍼)
+//
+// 변경 전: async_read(헤더) -> async_read(페이로드) 2단계 수신
+// 변경 후: async_read_some 1회 수신 후 완성된 프레임을 모두 디스패치
 // ==========================================
-void ServerSession::ReadHeader() {
+void ServerSession::DoRead() {
     auto self(shared_from_this());
-    boost::asio::async_read(socket_, boost::asio::buffer(&header_, sizeof(PacketHeader)),
+    socket_.async_read_some(stream_.GetWriteBuffers(),
         [this, self](boost::system::error_code ec, std::size_t length) {
             if (!ec) {
-                if (header_.size < sizeof(PacketHeader) || header_.size > MAX_PACKET_SIZE) {
-                    LOG_WARN("WorldServer", "잘못된 패킷 헤더 크기: " << header_.size);
-                    return;
-                }
-                uint16_t payload_size = static_cast<uint16_t>(header_.size - sizeof(PacketHeader));
-
-                if (payload_size == 0) {
-                    auto session_ptr = self;
-                    g_s2s_dispatcher.Dispatch(session_ptr, header_.id, nullptr, 0);
-                    ReadHeader();
-                }
-                else {
-                    // 고정 버퍼 크기 검증
-                    if (!assembler_.ValidatePayloadSize(payload_size)) {
-                        LOG_WARN("WorldServer", "S2S 페이로드 크기가 고정 버퍼 범위 초과: " << payload_size);
-                        return;
-                    }
-                    ReadPayload(payload_size);
-                }
+                stream_.CommitWrite(length);
+                if (!ProcessFrames()) return;
+                DoRead();
             }
             else {
-                auto result = NetworkUtils::HandleError("ServerSession::ReadHeader", ec);
+                auto result = NetworkUtils::HandleError("ServerSession::DoRead", ec);
                 if (result.should_disconnect || 
                     NetworkUtils::ClassifyError(ec) != NetworkUtils::ErrorSeverity::IGNORED_ERROR) {
                     LOG_INFO("WorldServer", "연동된 서버와의 연결이 해제되었습니다.");
@@ -140,31 +135,25 @@ void ServerSession::ReadHeader() {
         });
 }
 
-// ==========================================
-// ReadPayload - PacketAssembler 고정 버퍼에 수신
-//
-// 변경 전: payload_buf_.resize(payload_size) + 동적 버퍼에 수신
-// 변경 후: assembler_.GetBuffer()에 직접 수신 (고정 크기 사전 할당 버퍼)
-// ==========================================
-void ServerSession::ReadPayload(uint16_t payload_size) {
+bool ServerSession::ProcessFrames() {
     auto self(shared_from_this());
-    boost::asio::async_read(socket_,
-        boost::asio::buffer(assembler_.GetBuffer(), payload_size),
-        [this, self, payload_size](boost::system::error_code ec, std::size_t length) {
-            if (!ec) {
-                auto session_ptr = self;
-                g_s2s_dispatcher.Dispatch(
-                    session_ptr, header_.id, assembler_.GetPayloadData(), payload_size);
-                ReadHeader();
-            }
-            else {
-                auto result = NetworkUtils::HandleError("ServerSession::ReadPayload", ec);
-                if (result.should_disconnect || 
-                    NetworkUtils::ClassifyError(ec) != NetworkUtils::ErrorSeverity::IGNORED_ERROR) {
-                    OnDisconnected();
-                }
-            }
-        });
+    PacketArena::BatchScope arena_scope;    // 읽기 1회분 요청 메시지를 끝에서 일괄 회수
+
+    PacketFrame frame;
+    while (true) {
+        FrameResult result = stream_.PeekFrame(frame);
+        if (result == FrameResult::INCOMPLETE) break;
+
+        if (result == FrameResult::INVALID) {
+            LOG_WARN("WorldServer", "잘못된 패킷 헤더 크기: " << frame.size);
+            return false;
+        }
+
+        auto session_ptr = self;
+        g_s2s_dispatcher.Dispatch(session_ptr, frame.id, frame.payload, frame.payload_size);
+        stream_.ConsumeFrame(frame);
+    }
+    return true;
 }
 
 void ServerSession::OnDisconnected() {
@@ -240,7 +229,7 @@ int main() {
 
     SendBufferPool::GetInstance().Initialize(PoolConfig::LIGHT_SERVER);
 
-    g_s2s_dispatcher.RegisterHandler(Protocol::PKT_LOGIN_WORLD_SELECT_REQ, Handle_WorldLoginSelectReq);
+    g_s2s_dispatcher.RegisterHandler<&Handle_WorldLoginSelectReq>(Protocol::PKT_LOGIN_WORLD_SELECT_REQ);
 
     try {
         boost::asio::io_context io_context;
@@ -15,7 +15,9 @@
 
 #include "PacketDispatcher.h"
 #include "../Common/Network/PacketAssembler.h"
+#include "../Common/Network/SendQueue.h"
 #include "../Common/Define/SecurityConstants.h"
+#include "../Common/Define/GameConstants.h"
 #include "../Common/Utils/Lock.h"
 
 #pragma pack(push, 1)
@@ -97,13 +99,12 @@ private:
     boost::asio::ip::tcp::socket socket_;
 
     // strand + send_queue: concurrent async_write 방지
+    //   -> SendQueue: 쌓인 패킷을 gather write 1회로 묶어서 전송
     boost::asio::io_context::strand strand_;
-    std::deque<std::pair<std::shared_ptr<struct SendBuffer>, size_t>> send_queue_;
+    SendQueue send_queue_;
 
-    PacketHeader header_;
-
-    // std::vector<char> payload_buf_ 제거 -> PacketAssembler로 교체
-    PacketAssembler assembler_;
+    // 스트리밍 수신 링 버퍼 (async_read_some 1회에 여러 프레임 처리)
+    PacketStreamAssembler<GameConstants::Network::S2S_RECV_RING_SIZE> stream_;
 
 public:
     ServerSession(boost::asio::ip::tcp::socket socket) noexcept;
@@ -111,8 +112,8 @@ public:
     void Send(uint16_t pktId, const google::protobuf::Message& msg);
 
 private:
-    void ReadHeader();
-    void ReadPayload(uint16_t payload_size);
+    void DoRead();
+    bool ProcessFrames();
     void OnDisconnected();
-    void DoWrite();  // 큐에서 패킷을 꺼내 실제로 전송하는 내부 함수
+    void DoWrite();  // 큐에 쌓인 패킷을 묶어서 실제로 전송하는 내부 함수
 };